@@ -2,37 +2,45 @@ package org.example.project
 
 import android.content.Context
 import android.net.Uri
-import android.util.Log
-import com.cloudinary.android.MediaManager
-import com.cloudinary.android.callback.ErrorInfo
-import com.cloudinary.android.callback.UploadCallback
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.emitAll
+import kotlinx.coroutines.flow.filterIsInstance
+import kotlinx.coroutines.flow.first
+import kotlinx.coroutines.flow.flow
+import kotlinx.coroutines.withContext
+import org.example.project.image.CloudinaryTransport
+import org.example.project.image.ImagePreprocessor
+import org.example.project.image.ImageUploader
+import org.example.project.image.QueuedImageUploader
+import org.example.project.image.UploadProgress
+import java.io.IOException
 
 
 object CloudinaryUploader {
-    fun upload(
-        context: Context,
-        uri: Uri,
-        onResult: (String?) -> Unit
-    ) {
-        // MediaManager.init(...) must already have been called in your MyApp.onCreate
-        MediaManager.get().upload(uri)
-            .callback(object : UploadCallback {
-                override fun onStart(requestId: String) = Unit
-                override fun onProgress(requestId: String, bytes: Long, totalBytes: Long) = Unit
-                override fun onSuccess(requestId: String, resultData: Map<Any?, Any?>) {
-                    val url = resultData["secure_url"] as? String
-                    onResult(url)
-                }
-                override fun onError(requestId: String, error: ErrorInfo) {
-                    Log.e("Cloudinary", "Upload error: ${error.getDescription()}")
-                    onResult(null)
-                }
+    @Volatile
+    private var uploader: ImageUploader? = null
 
-                override fun onReschedule(requestId: String, error: ErrorInfo) {
-                    Log.w("Cloudinary", "Upload rescheduled: ${error.description}")
-                    onResult(null)
-                }
-            })
-            .dispatch()
+    // One queue per process, so every screen shares the same parallelism limit.
+    private fun uploader(context: Context): ImageUploader = uploader ?: synchronized(this) {
+        uploader ?: QueuedImageUploader(
+            CloudinaryTransport(),
+            // downscaled, upright, EXIF-free JPEG instead of the camera original
+            preprocessor = { ImagePreprocessor.forCurrentNetwork(context) }
+        ).also { uploader = it }
     }
-}
\ No newline at end of file
+
+    /** Progress of uploading [uri]; cancelling the collector cancels the upload. */
+    fun uploadWithProgress(context: Context, uri: Uri): Flow<UploadProgress> = flow {
+        val appContext = context.applicationContext
+        val original = withContext(Dispatchers.IO) {
+            appContext.contentResolver.openInputStream(uri)?.use { it.readBytes() }
+                ?: throw IOException("Cannot open $uri")
+        }
+        emitAll(uploader(appContext).upload(original))
+    }
+
+    /** Uploads [uri] and returns its secure URL. */
+    suspend fun upload(context: Context, uri: Uri): String =
+        uploadWithProgress(context, uri).filterIsInstance<UploadProgress.Done>().first().url
+}
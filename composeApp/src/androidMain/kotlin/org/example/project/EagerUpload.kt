@@ -0,0 +1,71 @@
+package org.example.project
+
+import android.content.Context
+import android.net.Uri
+import androidx.compose.runtime.Composable
+import androidx.compose.runtime.DisposableEffect
+import androidx.compose.runtime.remember
+import androidx.compose.runtime.rememberCoroutineScope
+import androidx.compose.ui.platform.LocalContext
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Deferred
+import kotlinx.coroutines.async
+import kotlin.coroutines.cancellation.CancellationException
+
+/**
+ * Upload that starts as soon as a photo is picked, while the user is still
+ * filling in the form. Saving then only waits for whatever is left of it, so
+ * in the common case the save costs just the report write.
+ *
+ * Picking again cancels the previous upload. Work runs in the screen's scope,
+ * so leaving the screen cancels it as well. Use it from the main thread.
+ */
+class EagerUpload(private val context: Context, private val scope: CoroutineScope) {
+    private var uri: Uri? = null
+    private var upload: Deferred<Result<String>>? = null
+
+    fun start(uri: Uri) {
+        upload?.cancel()
+        this.uri = uri
+        // failures are returned, not thrown, so they never cancel the screen's scope
+        upload = scope.async {
+            try {
+                Result.success(CloudinaryUploader.upload(context, uri))
+            } catch (e: CancellationException) {
+                throw e
+            } catch (e: Exception) {
+                Result.failure(e)
+            }
+        }
+    }
+
+    /**
+     * URL of [uri] once uploaded. Reuses the upload already running for it; one
+     * that failed in the background (e.g. offline at pick time) is retried once.
+     */
+    suspend fun await(uri: Uri): String {
+        val running = upload
+        if (running != null && this.uri == uri) {
+            running.await().onSuccess { return it }
+        }
+        start(uri)
+        return upload!!.await().getOrThrow()
+    }
+
+    fun cancel() {
+        upload?.cancel()
+        upload = null
+        uri = null
+    }
+}
+
+@Composable
+fun rememberEagerUpload(): EagerUpload {
+    val context = LocalContext.current.applicationContext
+    val scope = rememberCoroutineScope()
+    val upload = remember { EagerUpload(context, scope) }
+    DisposableEffect(upload) {
+        onDispose { upload.cancel() }
+    }
+    return upload
+}
@@ -1,13 +1,12 @@
 package org.example.project
 
-import kotlinx.serialization.encodeToString
-import kotlinx.serialization.json.Json
 import android.os.Bundle
 import androidx.activity.ComponentActivity
 import androidx.activity.compose.setContent
 import androidx.compose.foundation.layout.padding
 import androidx.compose.material3.MaterialTheme
 import androidx.compose.material3.Scaffold
+import androidx.compose.runtime.DisposableEffect
 import androidx.compose.runtime.LaunchedEffect
 import androidx.compose.runtime.collectAsState
 import androidx.compose.runtime.getValue
@@ -31,12 +30,11 @@ import org.example.project.ui.feed.FeedScreen
 import org.example.project.ui.report.NewReportScreen
 import org.example.project.data.report.ReportViewModel
 import androidx.compose.runtime.remember
-import org.example.project.data.report.ReportModel
+import org.example.project.data.report.ReportStore
 import org.example.project.data.report.ReportUiState
 import org.example.project.ui.report.EditReportScreen
 import org.example.project.ui.report.MyReportsScreen
 import org.example.project.ui.report.ReportDetailsScreen
-import java.net.URLDecoder
 
 
 @Suppress("NAME_SHADOWING")
@@ -159,21 +157,19 @@ class MainActivity : ComponentActivity() {
                         // 4) feed
                         composable("feed") {
                             val reportVm = remember { ReportViewModel() }
-                            val uiState by reportVm.uiState.collectAsState()
-                            LaunchedEffect(Unit) { reportVm.loadAllReports() }
-                            val reports = when (uiState) {
-                                is ReportUiState.ReportsLoaded -> (uiState as ReportUiState.ReportsLoaded).reports
-                                else -> emptyList()
+                            val mapPins by reportVm.mapPins.collectAsState()
+                            // live remote changes flow into SQLite while the feed is shown;
+                            // the map then queries only what it shows
+                            DisposableEffect(Unit) {
+                                val follow = reportVm.followRemoteChanges()
+                                onDispose { follow.close() }
                             }
                             val vmFeed: AndroidUserViewModel = viewModel()
                             FeedScreen(
-                                reports = reports,
-                                onReportClicked = { rpt ->
-                                    val json = kotlinx.serialization.json.Json.encodeToString(rpt)
-                                    val encoded = java.net.URLEncoder.encode(json, Charsets.UTF_8.name())
-                                    navController.navigate("report-details/$encoded")
-                                },
+                                mapPins = mapPins,
+                                onPinClicked = { id -> navController.navigate("report-details/$id") },
                                 onPublishClicked = { navController.navigate("new-report") },
+                                onViewportChanged = { bounds, zoom -> reportVm.onViewportChanged(bounds, zoom) },
                             )
                         }
 
@@ -242,49 +238,41 @@ class MainActivity : ComponentActivity() {
                             val currentUid by userVm.currentUid.collectAsState()
 
                             LaunchedEffect(currentUid) {
-                                currentUid?.let { reportVm.loadReportsForUser(it) }
+                                currentUid?.let { reportVm.loadReportPagesForUser(it) }
                             }
 
-                            val uiState by reportVm.uiState.collectAsState()
-                            val reports = when (uiState) {
-                                is ReportUiState.ReportsLoaded -> (uiState as ReportUiState.ReportsLoaded).reports
-                                else -> emptyList()
-                            }
-                            val isLoading = uiState is ReportUiState.LoadingReports
+                            val listState by reportVm.listState.collectAsState()
 
                             MyReportsScreen(
-                                reports = reports,
-                                isLoading = isLoading,
+                                reports = listState.reports,
+                                isLoading = listState.isLoading,
+                                hasMore = listState.hasMore,
+                                onLoadMore = { reportVm.loadMoreReports() },
                                 onPublishClicked = { navController.navigate("new-report") },
-                                onItemClick = { rpt ->
-                                    val json = Json.encodeToString(rpt)
-                                    val encoded = java.net.URLEncoder.encode(json, Charsets.UTF_8.name())
-                                    navController.navigate("report-details/$encoded")
-                                }
+                                onItemClick = { rpt -> navController.navigate("report-details/${rpt.id}") }
                             )
                         }
-                        composable("report-details/{reportJson}") { backStackEntry ->
-                            val raw = backStackEntry.arguments?.getString("reportJson").orEmpty()
-                            val decoded = URLDecoder.decode(raw, Charsets.UTF_8.name())
-                            val report = Json.decodeFromString<ReportModel>(decoded)
+                        // Routes carry only the id; the report comes from the shared store
+                        // and follows its SQLite row while the screen is open.
+                        composable("report-details/{reportId}") { backStackEntry ->
+                            val reportId = backStackEntry.arguments?.getString("reportId").orEmpty()
+                            val report by remember(reportId) { ReportStore.shared.observe(reportId) }
+                                .collectAsState(initial = ReportStore.shared.get(reportId))
 
                             // local VM to handle delete result
                             val reportVm = remember { ReportViewModel() }
                             val uiState by reportVm.uiState.collectAsState()
 
-                            ReportDetailsScreen(
-                                report = report,
-                                onEdit = {
-                                    val json = Json.encodeToString(report)
-                                    val encoded =
-                                        java.net.URLEncoder.encode(json, Charsets.UTF_8.name())
-                                    navController.navigate("edit-report/$encoded")
-                                },
-                                onDelete = {
-                                    // call shared delete
-                                    reportVm.deleteReport(report.id)
-                                }
-                            )
+                            report?.let { current ->
+                                ReportDetailsScreen(
+                                    report = current,
+                                    onEdit = { navController.navigate("edit-report/${current.id}") },
+                                    onDelete = {
+                                        // call shared delete
+                                        reportVm.deleteReport(current.id)
+                                    }
+                                )
+                            }
 
                             // after delete, go back to reports
                             LaunchedEffect(uiState) {
@@ -296,19 +284,19 @@ class MainActivity : ComponentActivity() {
                             }
                         }
 
-                        composable("edit-report/{reportJson}") { backStackEntry ->
-                            val raw = backStackEntry.arguments?.getString("reportJson").orEmpty()
-                            val decoded = java.net.URLDecoder.decode(raw, Charsets.UTF_8.name())
-                            val report = Json.decodeFromString<ReportModel>(decoded)
+                        composable("edit-report/{reportId}") { backStackEntry ->
+                            val reportId = backStackEntry.arguments?.getString("reportId").orEmpty()
+                            val report by remember(reportId) { ReportStore.shared.observe(reportId) }
+                                .collectAsState(initial = ReportStore.shared.get(reportId))
 
                             val reportVm = remember { ReportViewModel() }
                             val uiState by reportVm.uiState.collectAsState()
 
-                            EditReportScreen(
-                                report = report,
+                            report?.let { current -> EditReportScreen(
+                                report = current,
                                 onSave = { description, name, phone, isLost, lat, lng, imageUrl  ->
                                     reportVm.updateReport(
-                                        reportId = report.id,
+                                        reportId = current.id,
                                         description = description,
                                         name = name,
                                         phone = phone,
@@ -318,7 +306,7 @@ class MainActivity : ComponentActivity() {
                                         imageUrl = imageUrl
                                     )
                                 }
-                            )
+                            ) }
                             LaunchedEffect(uiState) {
                                 if (uiState is ReportUiState.UpdateSuccess) {
                                     navController.navigate("reports") {
@@ -4,6 +4,8 @@ import android.annotation.SuppressLint
 import android.app.Application
 import android.content.Context
 import com.cloudinary.android.MediaManager
+import org.example.project.data.report.DatabaseDriverFactory
+import org.example.project.data.report.DatabaseModule
 
 
 class MyApp : Application() {
@@ -15,6 +17,7 @@ class MyApp : Application() {
     override fun onCreate() {
         super.onCreate()
         ctx = applicationContext
+        DatabaseModule.init(DatabaseDriverFactory())
 
         val config = hashMapOf(
             "cloud_name" to "duk7ujnww",
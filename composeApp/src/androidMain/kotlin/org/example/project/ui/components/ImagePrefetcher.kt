@@ -0,0 +1,94 @@
+package org.example.project.ui.components
+
+import android.content.Context
+import coil3.SingletonImageLoader
+import coil3.decode.DataSource
+import coil3.request.Disposable
+import coil3.request.ImageRequest
+import org.example.project.image.PrefetchCandidate
+import org.example.project.image.PrefetchPlanner
+import org.example.project.image.PrefetchStats
+
+/**
+ * Warms Coil's memory and disk caches for the images the user is likely to
+ * open next. Screens call [update] with candidates, most likely first. The
+ * planner trims them to its count and byte budget, and at most [maxConcurrent]
+ * fetches run at once. A fetch whose image drops out of the plan is cancelled.
+ * Use it from the main thread only.
+ */
+class ImagePrefetcher(
+    private val context: Context,
+    val planner: PrefetchPlanner = PrefetchPlanner(),
+    private val maxConcurrent: Int = 2
+) {
+    val stats = PrefetchStats()
+
+    private var wanted: List<PrefetchCandidate> = emptyList()
+    // url -> request; null while enqueue has not returned yet
+    private val running = LinkedHashMap<String, Disposable?>()
+    // recently warmed urls, oldest first
+    private val warm = object : LinkedHashMap<String, Unit>(64, 0.75f, true) {
+        override fun removeEldestEntry(eldest: MutableMap.MutableEntry<String, Unit>?) = size > WARM_HISTORY
+    }
+
+    fun update(candidates: List<PrefetchCandidate>) {
+        wanted = planner.plan(candidates.filterNot { it.url in warm })
+        val keep = wanted.mapTo(HashSet()) { it.url }
+        running.keys.filterNot { it in keep }.forEach { url ->
+            running.remove(url)?.dispose()
+            stats.cancelled()
+        }
+        pump()
+    }
+
+    fun cancelAll() = update(emptyList())
+
+    /** Pass every shown image's data source here to count prefetch hits and misses. */
+    fun recordShown(dataSource: DataSource) = stats.shown(fromCache = dataSource != DataSource.NETWORK)
+
+    private fun pump() {
+        for (candidate in wanted) {
+            if (running.size >= maxConcurrent) break
+            if (candidate.url in running || candidate.url in warm) continue
+            start(candidate)
+        }
+    }
+
+    private fun start(candidate: PrefetchCandidate) {
+        val url = candidate.url
+        val request = ImageRequest.Builder(context)
+            .data(url)
+            .size(candidate.widthPx, candidate.heightPx)
+            .listener(
+                onSuccess = { _, _ -> finish(url, warmed = true) },
+                onError = { _, _ -> finish(url, warmed = false) }
+            )
+            .build()
+        stats.started()
+        running[url] = null
+        val disposable = SingletonImageLoader.get(context).enqueue(request)
+        // a memory-cache hit can finish before enqueue returns
+        if (running.containsKey(url)) running[url] = disposable
+    }
+
+    private fun finish(url: String, warmed: Boolean) {
+        if (!running.containsKey(url)) return
+        running.remove(url)
+        if (warmed) {
+            warm[url] = Unit
+            stats.completed()
+        }
+        pump()
+    }
+
+    companion object {
+        private const val WARM_HISTORY = 256
+
+        @Volatile
+        private var instance: ImagePrefetcher? = null
+
+        // One per process, so hits are counted against prefetches from any screen.
+        fun get(context: Context): ImagePrefetcher =
+            instance ?: ImagePrefetcher(context.applicationContext).also { instance = it }
+    }
+}
@@ -0,0 +1,47 @@
+package org.example.project.ui.components
+
+import androidx.compose.runtime.Composable
+import androidx.compose.runtime.remember
+import androidx.compose.ui.platform.LocalConfiguration
+import androidx.compose.ui.platform.LocalDensity
+import androidx.compose.ui.unit.Dp
+import androidx.compose.ui.unit.coerceAtLeast
+import androidx.compose.ui.unit.dp
+import org.example.project.image.ImageUrlBuilder
+import org.example.project.image.PrefetchCandidate
+import kotlin.math.roundToInt
+
+/** [url] resized by the CDN for a [width] x [height] slot on this screen. */
+@Composable
+fun sizedImageUrl(url: String, width: Dp, height: Dp): String {
+    val density = LocalDensity.current.density
+    return remember(url, width, height, density) { sizedImageUrl(url, width, height, density) }
+}
+
+/** Same, for an image that spans the screen width. */
+@Composable
+fun fullWidthImageUrl(url: String, height: Dp): String =
+    sizedImageUrl(url, LocalConfiguration.current.screenWidthDp.dp, height)
+
+/** Same, for a full-width image inside [horizontalInset] of padding on each side. */
+@Composable
+fun insetWidthImageUrl(url: String, horizontalInset: Dp, height: Dp): String =
+    sizedImageUrl(url, insetWidth(LocalConfiguration.current.screenWidthDp.dp, horizontalInset), height)
+
+/**
+ * Width a `fillMaxWidth` slot gets inside [horizontalInset] of padding on each side.
+ * The screen and anything prefetching for it must both use this: a bucket off by
+ * the padding is a different cache key, and the image is downloaded twice.
+ */
+fun insetWidth(screenWidth: Dp, horizontalInset: Dp): Dp =
+    (screenWidth - horizontalInset * 2).coerceAtLeast(0.dp)
+
+fun sizedImageUrl(url: String, width: Dp, height: Dp, density: Float): String =
+    ImageUrlBuilder.sized(url, width.value.toDouble(), height.value.toDouble(), density.toDouble())
+
+// The exact URL and pixel size a slot will request, so a warmed entry is reused.
+fun prefetchCandidate(url: String, width: Dp, height: Dp, density: Float) = PrefetchCandidate(
+    url = sizedImageUrl(url, width, height, density),
+    widthPx = (width.value * density).roundToInt(),
+    heightPx = (height.value * density).roundToInt()
+)
@@ -2,6 +2,10 @@ package org.example.project.ui.feed
 
 import android.Manifest
 import android.content.pm.PackageManager
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.graphics.Paint
+import android.location.Location
 import androidx.activity.compose.rememberLauncherForActivityResult
 import androidx.activity.result.contract.ActivityResultContracts
 import androidx.compose.foundation.layout.Box
@@ -13,32 +17,56 @@ import androidx.compose.material3.Icon
 import androidx.compose.material3.MaterialTheme
 import androidx.compose.material3.SmallFloatingActionButton
 import androidx.compose.runtime.Composable
+import androidx.compose.runtime.DisposableEffect
 import androidx.compose.runtime.LaunchedEffect
+import androidx.compose.runtime.derivedStateOf
+import androidx.compose.runtime.getValue
+import androidx.compose.runtime.key
 import androidx.compose.runtime.mutableStateOf
 import androidx.compose.runtime.remember
+import androidx.compose.runtime.rememberCoroutineScope
+import androidx.compose.runtime.setValue
+import androidx.compose.runtime.rememberUpdatedState
+import androidx.compose.runtime.snapshotFlow
 import androidx.compose.ui.Alignment
 import androidx.compose.ui.Modifier
+import androidx.compose.ui.geometry.Offset
 import androidx.compose.ui.graphics.Color
+import androidx.compose.ui.platform.LocalConfiguration
 import androidx.compose.ui.platform.LocalContext
+import androidx.compose.ui.platform.LocalDensity
 import androidx.compose.ui.tooling.preview.Preview
 import androidx.compose.ui.unit.dp
 import androidx.core.content.ContextCompat
 import com.google.android.gms.maps.CameraUpdateFactory
+import com.google.android.gms.maps.model.BitmapDescriptor
+import com.google.android.gms.maps.model.BitmapDescriptorFactory
 import com.google.android.gms.maps.model.LatLng
+import com.google.android.gms.maps.model.LatLngBounds
 import com.google.maps.android.compose.GoogleMap
 import com.google.maps.android.compose.MapProperties
 import com.google.maps.android.compose.MapUiSettings
 import com.google.maps.android.compose.Marker
 import com.google.maps.android.compose.MarkerState
 import com.google.maps.android.compose.rememberCameraPositionState
+import kotlinx.coroutines.CancellationException
 import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.launch
 import kotlinx.coroutines.withContext
-import org.example.project.data.report.ReportModel
+import org.example.project.data.report.MapPinClusters
+import org.example.project.geo.GeoBounds
+import kotlin.math.floor
 import org.example.project.location.getLocation
+import org.example.project.ui.components.ImagePrefetcher
+import org.example.project.ui.components.insetWidth
+import org.example.project.ui.components.prefetchCandidate
+import org.example.project.ui.report.DETAILS_IMAGE_HEIGHT
+import org.example.project.ui.report.DETAILS_IMAGE_INSET
 
 @Composable
-fun MapView( reports: List<ReportModel>,
-             onReportClicked: (ReportModel) -> Unit
+fun MapView( mapPins: MapPinClusters?,
+             onPinClicked: (reportId: String) -> Unit,
+             onViewportChanged: (GeoBounds, Double) -> Unit = { _, _ -> }
 ) {
     val context = LocalContext.current
 
@@ -76,19 +104,76 @@ fun MapView( reports: List<ReportModel>,
     // Fetch last location once we have permission
     LaunchedEffect(hasLocationPermission.value) {
         if (hasLocationPermission.value) {
-            runCatching { withContext(Dispatchers.IO) { getLocation() } }
-                .onSuccess { loc ->
-                    val here = LatLng(loc.latitude, loc.longitude)
-                    cameraState.move(CameraUpdateFactory.newLatLngZoom(here, 16f))
-                }
+            val loc = try {
+                withContext(Dispatchers.IO) { getLocation() }
+            } catch (e: CancellationException) {
+                throw e
+            } catch (e: Throwable) {
+                null
+            }
+            loc?.let {
+                val here = LatLng(it.latitude, it.longitude)
+                cameraState.move(CameraUpdateFactory.newLatLngZoom(here, 16f))
+            }
+        }
+    }
+
+    // Report the visible region on every camera change (the view model debounces);
+    // clusters are only recomputed once the camera comes to rest.
+    val latestOnViewportChanged by rememberUpdatedState(onViewportChanged)
+    var viewport by remember { mutableStateOf<GeoBounds?>(null) }
+    fun reportViewport(settled: Boolean = true) {
+        cameraState.projection?.visibleRegion?.latLngBounds?.let {
+            val bounds = it.toGeoBounds()
+            if (settled) viewport = bounds
+            latestOnViewportChanged(bounds, cameraState.position.zoom.toDouble())
         }
     }
+    LaunchedEffect(cameraState) {
+        snapshotFlow { cameraState.isMoving to cameraState.position }
+            .collect { (moving, _) -> reportViewport(settled = !moving) }
+    }
+
+    // Clusters: the view model builds the index off the main thread with each pin load;
+    // it is queried again only when the viewport settles or the whole zoom level changes.
+    val zoomLevel by remember { derivedStateOf { floor(cameraState.position.zoom.toDouble()) } }
+    val clusters = remember(mapPins, viewport, zoomLevel) {
+        val bounds = viewport
+        if (mapPins == null || bounds == null) emptyList()
+        else mapPins.index.getClusters(bounds.expandedBy(0.5), zoomLevel)
+    }
+    val pins = mapPins?.pins
+    val scope = rememberCoroutineScope()
+    val density = LocalDensity.current.density
+
+    // Warm the details image of the pins nearest the middle of the map: those are
+    // the ones a tap is most likely to open. Recomputed when the camera settles.
+    val prefetcher = remember { ImagePrefetcher.get(context) }
+    val detailsWidth = insetWidth(LocalConfiguration.current.screenWidthDp.dp, DETAILS_IMAGE_INSET)
+    LaunchedEffect(clusters) {
+        val bounds = viewport ?: return@LaunchedEffect
+        if (pins == null) return@LaunchedEffect
+        val center = cameraState.position.target
+        val nearest = clusters
+            .filter { it.item?.let(pins::hasImage) == true && bounds.contains(it.lat, it.lng) }
+            .sortedBy { FloatArray(1).also { d ->
+                Location.distanceBetween(center.latitude, center.longitude, it.lat, it.lng, d)
+            }[0] }
+            .take(prefetcher.planner.maxAhead)
+        prefetcher.update(nearest.map {
+            prefetchCandidate(pins.imageUrl(it.item!!), detailsWidth, DETAILS_IMAGE_HEIGHT, density)
+        })
+    }
+    DisposableEffect(Unit) {
+        onDispose { prefetcher.cancelAll() }
+    }
 
     GoogleMap(
         modifier = Modifier
             .fillMaxSize()
             .padding(top = 32.dp, bottom = 80.dp),
         cameraPositionState = cameraState,
+        onMapLoaded = { reportViewport() },
         properties = MapProperties(
             isMyLocationEnabled = hasLocationPermission.value
         ),
@@ -98,41 +183,100 @@ fun MapView( reports: List<ReportModel>,
         )
     )
     {
-        // 🔴 Pins for ALL reports that have coordinates
-        reports.forEach { rpt ->
-            val lat = rpt.lat
-            val lng = rpt.lng
-            if (lat != null && lng != null) {
-                val pos = LatLng(lat, lng)
-                Marker(
-                    state = MarkerState(position = pos),
-                    title = if (rpt.name.isNotBlank()) rpt.name
-                    else if (rpt.isLost) "Lost" else "Found",
-                    snippet = rpt.description.take(60),
-                    onClick = {
-                        onReportClicked(rpt)   // navigate to details
-                        true                   // consume click
-                    }
-                )
+        // 🔴 One pin per report, or one bubble per cluster of nearby reports
+        clusters.forEach { cluster ->
+            key(cluster.id) {
+                val pos = LatLng(cluster.lat, cluster.lng)
+                val pin = cluster.item
+                if (pin != null && pins != null) {
+                    val label = pins.label(pin)
+                    Marker(
+                        state = MarkerState(position = pos),
+                        title = if (label.isNotBlank()) label
+                        else if (pins.isLost(pin)) "Lost" else "Found",
+                        onClick = {
+                            onPinClicked(pins.id(pin))   // navigate to details
+                            true                         // consume click
+                        }
+                    )
+                } else {
+                    Marker(
+                        state = MarkerState(position = pos),
+                        icon = clusterIcon(cluster.count, mapPins?.truncated == true, density),
+                        anchor = Offset(0.5f, 0.5f),
+                        onClick = {
+                            // zoom in until the cluster breaks apart
+                            scope.launch {
+                                cameraState.animate(
+                                    CameraUpdateFactory.newLatLngZoom(pos, cluster.expansionZoom.toFloat())
+                                )
+                            }
+                            true
+                        }
+                    )
+                }
             }
         }
     }
 }
 
 
+private val clusterIcons = mutableMapOf<String, BitmapDescriptor>()
+
+// Round count bubble; cached per label since clusters are redrawn on every zoom step.
+// Counts from a truncated pin load are lower bounds and get a "+".
+private fun clusterIcon(count: Int, truncated: Boolean, density: Float): BitmapDescriptor {
+    val label = when {
+        count >= 1000 -> "${count / 1000}k+"
+        truncated -> "$count+"
+        else -> count.toString()
+    }
+    return clusterIcons.getOrPut(label) {
+        val size = (40 * density).toInt()
+        val bitmap = Bitmap.createBitmap(size, size, Bitmap.Config.ARGB_8888)
+        val canvas = Canvas(bitmap)
+        val fill = Paint(Paint.ANTI_ALIAS_FLAG).apply { color = 0xFFE53935.toInt() }
+        val ring = Paint(Paint.ANTI_ALIAS_FLAG).apply {
+            color = android.graphics.Color.WHITE
+            style = Paint.Style.STROKE
+            strokeWidth = 2 * density
+        }
+        val text = Paint(Paint.ANTI_ALIAS_FLAG).apply {
+            color = android.graphics.Color.WHITE
+            textSize = 14 * density
+            textAlign = Paint.Align.CENTER
+            isFakeBoldText = true
+        }
+        val r = size / 2f
+        canvas.drawCircle(r, r, r - ring.strokeWidth, fill)
+        canvas.drawCircle(r, r, r - ring.strokeWidth, ring)
+        canvas.drawText(label, r, r - (text.descent() + text.ascent()) / 2, text)
+        BitmapDescriptorFactory.fromBitmap(bitmap)
+    }
+}
+
+private fun LatLngBounds.toGeoBounds() = GeoBounds(
+    south = southwest.latitude,
+    west = southwest.longitude,
+    north = northeast.latitude,
+    east = northeast.longitude
+)
+
 @Composable
 fun FeedScreen(
-    reports: List<ReportModel>,
-    onReportClicked: (ReportModel) -> Unit,
-    onPublishClicked: () -> Unit = {}
+    mapPins: MapPinClusters?,
+    onPinClicked: (reportId: String) -> Unit,
+    onPublishClicked: () -> Unit = {},
+    onViewportChanged: (GeoBounds, Double) -> Unit = { _, _ -> }
 ) {
     Box(
         modifier = Modifier.fillMaxSize(),
         contentAlignment = Alignment.Center
     ) {
         MapView(
-            reports = reports,
-            onReportClicked = onReportClicked
+            mapPins = mapPins,
+            onPinClicked = onPinClicked,
+            onViewportChanged = onViewportChanged
         )
         SmallFloatingActionButton(
             onClick = onPublishClicked,
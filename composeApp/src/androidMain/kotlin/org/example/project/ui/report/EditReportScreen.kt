@@ -1,6 +1,5 @@
 package org.example.project.ui.report
 
-import android.content.Context
 import android.location.Geocoder
 import androidx.activity.compose.rememberLauncherForActivityResult
 import androidx.activity.result.contract.ActivityResultContracts
@@ -31,16 +30,15 @@ import androidx.compose.material.icons.Icons
 import androidx.compose.material.icons.filled.Close
 import androidx.compose.material.icons.filled.Edit
 import coil3.compose.AsyncImage
-import com.cloudinary.android.MediaManager
+import org.example.project.ui.components.fullWidthImageUrl
 import com.google.android.gms.maps.model.LatLng
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.launch
-import kotlinx.coroutines.suspendCancellableCoroutine
 import kotlinx.coroutines.withContext
 import org.example.project.R
+import org.example.project.rememberEagerUpload
 import org.example.project.data.report.ReportModel
 import java.util.Locale
-import kotlin.coroutines.resumeWithException
 
 
 private val balooBhaijaan2Family = FontFamily(
@@ -63,12 +61,18 @@ fun EditReportScreen(
 ) {
 
     var localImageUri by remember { mutableStateOf<Uri?>(null) }
+    // uploads while the user edits; saving only waits for the rest
+    val imageUpload = rememberEagerUpload()
 
     val picker = rememberLauncherForActivityResult(
         contract = ActivityResultContracts.PickVisualMedia()
-    ) { uri -> if (uri != null) localImageUri = uri }
+    ) { uri ->
+        if (uri != null) {
+            localImageUri = uri
+            imageUpload.start(uri)
+        }
+    }
     val scope = rememberCoroutineScope()
-    val context = LocalContext.current
 
 
     // Text fields
@@ -151,7 +155,7 @@ fun EditReportScreen(
                     .clip(RoundedCornerShape(8.dp))
             ) {
                 AsyncImage(
-                    model = localImageUri ?: report.imageUrl,
+                    model = localImageUri ?: fullWidthImageUrl(report.imageUrl, 220.dp),
                     contentDescription = null,
                     modifier = Modifier.matchParentSize(),
                     contentScale = ContentScale.Crop
@@ -216,12 +220,12 @@ fun EditReportScreen(
                     locationErr = "Please pick a location before saving."
                     return@Button
                 }
-                var finalUrl: String? = null
-                if (localImageUri != null) {
+                val pickedUri = localImageUri
+                if (pickedUri != null) {
                     // use a scope tied to composition rather than creating a new one
                     scope.launch {
                         try {
-                            finalUrl = uploadToCloudinary(context, localImageUri!!)
+                            val finalUrl = imageUpload.await(pickedUri)
                             onSave(description, name, phone, isLost, lat, lng, finalUrl)
                         } catch (_: Throwable) {
                             onSave(description, name, phone, isLost, lat, lng, report.imageUrl)
@@ -263,30 +267,6 @@ fun EditReportScreen(
 }
 
 
-suspend fun uploadToCloudinary(ctx: Context, uri: Uri): String =
-    withContext(Dispatchers.IO) {
-        suspendCancellableCoroutine { cont ->
-            MediaManager.get().upload(uri)
-                .option("resource_type", "image")
-                .callback(object : com.cloudinary.android.callback.UploadCallback {
-                    override fun onStart(requestId: String?) {}
-                    override fun onProgress(requestId: String?, bytes: Long, total: Long) {}
-                    override fun onSuccess(requestId: String?, resultData: Map<*, *>) {
-                        val url = (resultData["secure_url"] ?: resultData["url"])?.toString()
-                        if (url != null) cont.resume(url) {} else cont.resumeWithException(IllegalStateException("No URL"))
-                    }
-                    override fun onError(requestId: String?, error: com.cloudinary.android.callback.ErrorInfo?) {
-                        cont.resumeWithException(RuntimeException(error?.description ?: "Upload failed"))
-                    }
-                    override fun onReschedule(requestId: String?, error: com.cloudinary.android.callback.ErrorInfo?) {
-                        cont.resumeWithException(RuntimeException(error?.description ?: "Upload rescheduled"))
-                    }
-                })
-                .dispatch(ctx)
-        }
-    }
-
-
 @Composable
 private fun LabeledEditor(
     label: String,
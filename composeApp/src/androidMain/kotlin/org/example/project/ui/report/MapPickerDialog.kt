@@ -22,6 +22,7 @@ import androidx.core.content.ContextCompat
 import com.google.android.gms.maps.CameraUpdateFactory
 import com.google.android.gms.maps.model.LatLng
 import com.google.maps.android.compose.*
+import kotlinx.coroutines.CancellationException
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.launch
 import kotlinx.coroutines.withContext
@@ -57,7 +58,13 @@ fun MapPickerDialog(
     LaunchedEffect(hasPermission) {
         if (hasPermission) {
             waitingForFirstFix = true
-            val loc = runCatching { withContext(Dispatchers.IO) { getLocation() } }.getOrNull()
+            val loc = try {
+                withContext(Dispatchers.IO) { getLocation() }
+            } catch (e: CancellationException) {
+                throw e
+            } catch (e: Throwable) {
+                null
+            }
             loc?.let {
                 val here = LatLng(it.latitude, it.longitude)
                 picked = here                    // preselect current location (optional)
@@ -6,16 +6,25 @@ import androidx.compose.foundation.clickable
 import androidx.compose.foundation.layout.*
 import androidx.compose.foundation.lazy.LazyColumn
 import androidx.compose.foundation.lazy.items
+import androidx.compose.foundation.lazy.rememberLazyListState
 import androidx.compose.foundation.shape.RoundedCornerShape
 import androidx.compose.material.icons.Icons
 import androidx.compose.material.icons.filled.Add
 import androidx.compose.material3.*
 import androidx.compose.runtime.Composable
+import androidx.compose.runtime.LaunchedEffect
+import androidx.compose.runtime.derivedStateOf
+import androidx.compose.runtime.getValue
+import androidx.compose.runtime.remember
+import androidx.compose.runtime.rememberUpdatedState
+import androidx.compose.runtime.snapshotFlow
 import androidx.compose.ui.Alignment
 import androidx.compose.ui.Modifier
 import androidx.compose.ui.draw.clip
 import androidx.compose.ui.graphics.Color
 import androidx.compose.ui.layout.ContentScale
+import androidx.compose.ui.platform.LocalContext
+import androidx.compose.ui.platform.LocalDensity
 import androidx.compose.ui.text.font.Font
 import androidx.compose.ui.text.font.FontFamily
 import androidx.compose.ui.text.font.FontWeight
@@ -24,7 +33,10 @@ import androidx.compose.ui.unit.dp
 import coil3.compose.AsyncImage
 import org.example.project.R
 import org.example.project.data.report.ReportModel
+import org.example.project.ui.components.ImagePrefetcher
 import org.example.project.ui.components.LoadingAnimation
+import org.example.project.ui.components.prefetchCandidate
+import org.example.project.ui.components.sizedImageUrl
 
 private val balooBhaijaan2Family = FontFamily(
     Font(R.font.baloobhaijaan2_regular,   FontWeight.Normal),
@@ -34,34 +46,102 @@ private val balooBhaijaan2Family = FontFamily(
     Font(R.font.baloobhaijaan2_extrabold, FontWeight.ExtraBold)
 )
 
+// Rows left below the viewport when the next page is requested
+private const val LOAD_MORE_THRESHOLD = 5
+
+private val THUMBNAIL_SIZE = 88.dp
+
+// Weight of the newest sample in the smoothed scroll velocity
+private const val VELOCITY_SMOOTHING = 0.3
+
 @Composable
 fun MyReportsScreen(
     reports: List<ReportModel>,
     onPublishClicked: () -> Unit,
     onItemClick: (ReportModel) -> Unit = {},
-    isLoading: Boolean = false
+    isLoading: Boolean = false,
+    hasMore: Boolean = false,
+    onLoadMore: () -> Unit = {}
 ) {
-    val sortedReports = reports.sortedByDescending { it.id }
+    // reports arrive newest first, one page at a time
+    val listState = rememberLazyListState()
+    val nearEnd by remember {
+        derivedStateOf {
+            val info = listState.layoutInfo
+            val lastVisible = info.visibleItemsInfo.lastOrNull()?.index ?: 0
+            lastVisible >= info.totalItemsCount - LOAD_MORE_THRESHOLD
+        }
+    }
+    LaunchedEffect(nearEnd, hasMore, reports.size) {
+        if (nearEnd && hasMore) onLoadMore()
+    }
 
+    // Warm the thumbnails just past the viewport in the direction of travel
+    val context = LocalContext.current
+    val density = LocalDensity.current.density
+    val prefetcher = remember { ImagePrefetcher.get(context) }
+    val currentReports by rememberUpdatedState(reports)
+    LaunchedEffect(listState) {
+        var lastIndex = listState.firstVisibleItemIndex
+        var lastNanos = System.nanoTime()
+        var velocity = 0.0   // items per second, smoothed
+        snapshotFlow {
+            Triple(
+                listState.firstVisibleItemIndex,
+                listState.layoutInfo.visibleItemsInfo.lastOrNull()?.index ?: 0,
+                listState.isScrollInProgress
+            )
+        }.collect { (first, last, scrolling) ->
+            val now = System.nanoTime()
+            val seconds = (now - lastNanos) / 1e9
+            velocity = when {
+                !scrolling -> 0.0
+                seconds > 0 -> velocity + VELOCITY_SMOOTHING * ((first - lastIndex) / seconds - velocity)
+                else -> velocity
+            }
+            lastIndex = first
+            lastNanos = now
+
+            val list = currentReports
+            val ahead = prefetcher.planner.listAhead(first, last, list.size, velocity)
+            prefetcher.update(
+                ahead.mapNotNull { list.getOrNull(it)?.imageUrl?.takeIf(String::isNotBlank) }
+                    .map { prefetchCandidate(it, THUMBNAIL_SIZE, THUMBNAIL_SIZE, density) }
+            )
+        }
+    }
 
     Box(
         Modifier
             .fillMaxSize()
             .background(Color(0xFFF0F0F0))
     ) {
-        if (sortedReports.isEmpty()) {
+        if (reports.isEmpty()) {
             Box(Modifier.fillMaxSize(), contentAlignment = Alignment.Center) {
                 Text("No reports yet")
             }
         } else {
             LazyColumn(
                 modifier = Modifier.fillMaxSize(),
+                state = listState,
                 contentPadding = PaddingValues(top = 12.dp)
             ) {
-                items(sortedReports, key = { it.id }) { rpt ->
-                    ReportItem(rpt = rpt, onClick = { onItemClick(rpt) })
+                items(reports, key = { it.id }) { rpt ->
+                    ReportItem(rpt = rpt, onClick = { onItemClick(rpt) }, prefetcher = prefetcher)
 
                 }
+                if (hasMore) {
+                    item(key = "load-more") {
+                        Box(
+                            Modifier
+                                .fillMaxWidth()
+                                .padding(16.dp),
+                            contentAlignment = Alignment.Center
+                        ) {
+                            CircularProgressIndicator(Modifier.size(24.dp), strokeWidth = 2.dp)
+                        }
+                    }
+                }
             }
         }
 
@@ -81,7 +161,8 @@ fun MyReportsScreen(
 @Composable
 private fun ReportItem(
     rpt: ReportModel,
-    onClick: () -> Unit
+    onClick: () -> Unit,
+    prefetcher: ImagePrefetcher
 ) {
     val title = if (rpt.name.isNotBlank()) rpt.name else rpt.description
 
@@ -103,12 +184,13 @@ private fun ReportItem(
         ) {
             if (rpt.imageUrl.isNotBlank()) {
                 AsyncImage(
-                    model = rpt.imageUrl,
+                    model = sizedImageUrl(rpt.imageUrl, THUMBNAIL_SIZE, THUMBNAIL_SIZE),
                     contentDescription = null,
                     modifier = Modifier
-                        .size(88.dp)
+                        .size(THUMBNAIL_SIZE)
                         .clip(RoundedCornerShape(14.dp)),
-                    contentScale = ContentScale.Crop
+                    contentScale = ContentScale.Crop,
+                    onSuccess = { prefetcher.recordShown(it.result.dataSource) }
                 )
             } else {
                 // gray placeholder
@@ -34,7 +34,9 @@ import androidx.compose.material.icons.filled.Add
 import androidx.compose.ui.draw.clip
 import androidx.compose.ui.layout.ContentScale
 import coil3.compose.rememberAsyncImagePainter
-import org.example.project.CloudinaryUploader
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.launch
+import org.example.project.rememberEagerUpload
 
 private val balooBhaijaan2Family = FontFamily(
     Font(R.font.baloobhaijaan2_regular,   FontWeight.Normal),
@@ -63,6 +65,9 @@ fun NewReportScreen(
     var cameraUri by remember { mutableStateOf<Uri?>(null) }
     var selectedImageUri by remember { mutableStateOf<Uri?>(null) }
     var uploading by remember { mutableStateOf(false) }
+    // the photo starts uploading when picked; publish only waits for the rest
+    val imageUpload = rememberEagerUpload()
+    val scope = rememberCoroutineScope()
 
     // NEW: error message
     var errorText by remember { mutableStateOf<String?>(null) }
@@ -72,6 +77,7 @@ fun NewReportScreen(
     ) { uri: Uri? ->
         uri?.let {
             selectedImageUri = it
+            imageUpload.start(it)
             onImagePicked(it)
             errorText = null // clear error if user fixed it
         }
@@ -83,6 +89,7 @@ fun NewReportScreen(
         if (success) {
             cameraUri?.let {
                 selectedImageUri = it
+                imageUpload.start(it)
                 onImagePicked(it)
                 errorText = null
             }
@@ -324,9 +331,18 @@ fun NewReportScreen(
 
                     val (lat, lng) = currentPicked!!
                     selectedImageUri?.let { uri ->
+                        if (uploading) return@Button
                         uploading = true
                         errorText = null
-                        CloudinaryUploader.upload(context, uri) { url ->
+                        scope.launch {
+                            // a cancelled scope (the screen left) stops here instead of publishing
+                            val url = try {
+                                imageUpload.await(uri)
+                            } catch (e: CancellationException) {
+                                throw e
+                            } catch (e: Throwable) {
+                                null
+                            }
                             uploading = false
                             url?.let { imageUrl ->
                                 onPublish(
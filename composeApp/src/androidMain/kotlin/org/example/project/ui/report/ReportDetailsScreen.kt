@@ -28,6 +28,8 @@ import androidx.compose.ui.text.withStyle
 import androidx.compose.ui.unit.dp
 import androidx.compose.ui.unit.sp
 import coil3.compose.AsyncImage
+import org.example.project.ui.components.ImagePrefetcher
+import org.example.project.ui.components.insetWidthImageUrl
 import com.google.android.gms.maps.model.CameraPosition
 import com.google.android.gms.maps.model.LatLng
 import com.google.maps.android.compose.GoogleMap
@@ -56,6 +58,12 @@ private val PrimaryPink = Color(0xFFFFC0C0)
 private val LabelGray   = Color(0xFF8D8D8D)
 private val CardStroke  = Color(0xFFD6D6D6)
 
+// Shared with the map so it can warm exactly the URL and size this screen will request
+internal val DETAILS_IMAGE_HEIGHT = 220.dp
+private val SCREEN_PADDING = 24.dp
+private val CARD_PADDING = 16.dp
+internal val DETAILS_IMAGE_INSET = SCREEN_PADDING + CARD_PADDING
+
 @Composable
 fun ReportDetailsScreen(
     report: ReportModel,
@@ -66,7 +74,7 @@ fun ReportDetailsScreen(
         modifier = Modifier
             .fillMaxSize()
             .background(BgGray)
-            .padding(horizontal = 24.dp, vertical = 16.dp),
+            .padding(horizontal = SCREEN_PADDING, vertical = 16.dp),
     ) {
         val scroll = rememberScrollState()
 
@@ -74,17 +82,19 @@ fun ReportDetailsScreen(
             modifier = Modifier
                 .fillMaxSize()
                 .verticalScroll(scroll)
-                .padding(horizontal = 16.dp, vertical = 12.dp),
+                .padding(horizontal = CARD_PADDING, vertical = 12.dp),
             verticalArrangement = Arrangement.spacedBy(8.dp)
         ) {
+            val context = LocalContext.current
             AsyncImage(
-                model = report.imageUrl,
+                model = insetWidthImageUrl(report.imageUrl, DETAILS_IMAGE_INSET, DETAILS_IMAGE_HEIGHT),
                 contentDescription = null,
                 modifier = Modifier
                     .fillMaxWidth()
-                    .height(220.dp)
+                    .height(DETAILS_IMAGE_HEIGHT)
                     .clip(RoundedCornerShape(8.dp)),
-                contentScale = ContentScale.Crop
+                contentScale = ContentScale.Crop,
+                onSuccess = { ImagePrefetcher.get(context).recordShown(it.result.dataSource) }
             )
 
             Text(
@@ -104,7 +114,6 @@ fun ReportDetailsScreen(
 
             val lat = report.lat
             val lng = report.lng
-            val context = LocalContext.current
 
             if (lat != null && lng != null) {
                 Text(
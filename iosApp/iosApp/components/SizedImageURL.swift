@@ -0,0 +1,17 @@
+import UIKit
+import Shared
+
+/// `url` resized by the CDN for a `width` x `height` slot (in points) on this screen.
+func sizedImageURL(_ url: String, width: CGFloat, height: CGFloat) -> URL? {
+    URL(string: ImageUrlBuilder.shared.sized(
+        url: url,
+        widthDp: Double(width),
+        heightDp: Double(height),
+        density: Double(UIScreen.main.scale)
+    ))
+}
+
+/// Same, for an image that spans the screen width.
+func fullWidthImageURL(_ url: String, height: CGFloat) -> URL? {
+    sizedImageURL(url, width: UIScreen.main.bounds.width, height: height)
+}
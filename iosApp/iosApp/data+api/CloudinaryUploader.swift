@@ -1,29 +1,125 @@
 import Foundation
 import Cloudinary
+import Shared
 
 struct CloudinaryUploader {
-  /// Uploads JPEG data (signed with your API secret), calls back with the secure URL or `nil` on failure.
+  /// Uploads the photo through the shared upload queue (see `QueuedImageUploader`), which
+  /// downscales and recompresses it first, and calls back with the secure URL or `nil`.
+  /// Close the returned handle to cancel.
+  @discardableResult
   static func upload(
     _ data: Data,
+    onProgress: @escaping (Double) -> Void = { _ in },
     completion: @escaping (String?) -> Void
-  ) {
+  ) -> Closeable {
+    ImageUploads.shared.start(
+      data: data,
+      onProgress: { progress in
+        if let sending = progress as? UploadProgressSending {
+          onProgress(Double(sending.fraction))
+        } else if let done = progress as? UploadProgressDone {
+          completion(done.url)
+        }
+      },
+      onError: { error in
+        print("⛔️ Image upload failed:", error.message ?? "unknown")
+        completion(nil)
+      }
+    )
+  }
+
+  /// Async form of `upload(_:completion:)`. Cancelling the calling task cancels the upload.
+  static func upload(imageData data: Data) async throws -> String {
+    let handle = UploadHandle()
+    return try await withTaskCancellationHandler {
+      try await withCheckedThrowingContinuation { cont in
+        handle.begin(cont) {
+          upload(data) { url in
+            handle.finish(url.map { Result<String, Error>.success($0) } ?? .failure(NSError(domain: "Cloudinary", code: -1)))
+          }
+        }
+      }
+    } onCancel: {
+      handle.cancel()
+    }
+  }
+}
+
+/// The Kotlin side of uploads cannot call the Swift-only Cloudinary SDK, so this
+/// does it on its behalf. Installed at launch in `AppDelegate`.
+final class CloudinarySDKBridge: CloudinaryBridge {
+  func upload(
+    data: Data,
+    onProgress: @escaping (KotlinLong, KotlinLong) -> Void,
+    onComplete: @escaping (String?, String?) -> Void
+  ) -> Closeable {
     let params = CLDUploadRequestParams()
       .setResourceType(.image)
       // optionally: .setFolder("reports")
-    
-    CloudinaryManager.shared
+
+    let request = CloudinaryManager.shared
       .createUploader()
       .signedUpload(
         data: data,
         params: params,
-        progress: nil
+        progress: { progress in
+          onProgress(KotlinLong(value: progress.completedUnitCount), KotlinLong(value: progress.totalUnitCount))
+        }
       ) { result, error in
         if let secureUrl = result?.secureUrl {
-          completion(secureUrl)
+          onComplete(secureUrl, nil)
         } else {
-          print("⛔️ Cloudinary signedUpload failed:", error?.localizedDescription ?? "unknown")
-          completion(nil)
+          onComplete(nil, error?.localizedDescription ?? "Cloudinary signedUpload failed")
         }
       }
+    return UploadRequestCloser(request: request)
+  }
+}
+
+private final class UploadRequestCloser: Closeable {
+  let request: CLDUploadRequest
+  init(request: CLDUploadRequest) { self.request = request }
+  func close() { request.cancel() }
+}
+
+/// Resumes a Swift task exactly once: with the upload's result, or with
+/// `CancellationError` when the task is cancelled, which also stops the upload.
+private final class UploadHandle {
+  private let lock = NSLock()
+  private var continuation: CheckedContinuation<String, Error>?
+  private var upload: Closeable?
+  private var cancelled = false
+
+  func begin(_ continuation: CheckedContinuation<String, Error>, start: () -> Closeable) {
+    lock.lock()
+    if cancelled {
+      lock.unlock()
+      continuation.resume(throwing: CancellationError())
+      return
+    }
+    self.continuation = continuation
+    lock.unlock()
+    let upload = start()
+    lock.lock(); defer { lock.unlock() }
+    if cancelled { upload.close() } else { self.upload = upload }
+  }
+
+  func finish(_ result: Result<String, Error>) {
+    lock.lock()
+    let continuation = self.continuation
+    self.continuation = nil
+    lock.unlock()
+    continuation?.resume(with: result)
+  }
+
+  func cancel() {
+    lock.lock()
+    cancelled = true
+    let upload = self.upload
+    let continuation = self.continuation
+    self.continuation = nil
+    lock.unlock()
+    upload?.close()
+    continuation?.resume(throwing: CancellationError())
   }
 }
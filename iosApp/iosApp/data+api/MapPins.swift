@@ -0,0 +1,47 @@
+import Foundation
+import CoreLocation
+import Shared
+
+/// A `MapPinBatch` copied out of Kotlin as four contiguous buffers. Reading a pin
+/// afterwards never crosses the bridge, and there is no object per report.
+struct MapPins {
+    static let empty = MapPins()
+
+    let count: Int
+    private let coordinates: [Double]   // lat, lng interleaved
+    private let flags: [UInt8]
+    private let strings: Data           // UTF-8: id, label, image URL, id, ...
+    private let offsets: [Int32]        // 3 * count + 1 boundaries into `strings`
+
+    private init() {
+        count = 0
+        coordinates = []
+        flags = []
+        strings = Data()
+        offsets = [0]
+    }
+
+    init(_ batch: MapPinBatch) {
+        count = Int(batch.size)
+        coordinates = batch.coordinatesData().withUnsafeBytes { Array($0.bindMemory(to: Double.self)) }
+        flags = [UInt8](batch.flagsData())
+        strings = batch.stringsData()
+        offsets = batch.stringOffsetsData().withUnsafeBytes { Array($0.bindMemory(to: Int32.self)) }
+    }
+
+    func coordinate(at i: Int) -> CLLocationCoordinate2D {
+        CLLocationCoordinate2D(latitude: coordinates[2 * i], longitude: coordinates[2 * i + 1])
+    }
+
+    func isLost(at i: Int) -> Bool { flags[i] & UInt8(MapPinBatch.companion.LOST) != 0 }
+    func hasImage(at i: Int) -> Bool { flags[i] & UInt8(MapPinBatch.companion.HAS_IMAGE) != 0 }
+    func id(at i: Int) -> String { string(3 * i) }
+    func label(at i: Int) -> String { string(3 * i + 1) }
+    func imageUrl(at i: Int) -> String { string(3 * i + 2) }
+
+    private func string(_ slot: Int) -> String {
+        let start = strings.startIndex + Int(offsets[slot])
+        let end = strings.startIndex + Int(offsets[slot + 1])
+        return String(decoding: strings[start..<end], as: UTF8.self)
+    }
+}
@@ -2,15 +2,14 @@ import SwiftUI
 import Shared
 
 struct ReportsContainerView: View {
-  // Instantiate with the new zero-arg init
-  private let reportVm = ReportViewModel()
+  @StateObject private var reportVm = ReportViewModelHolder()
 
   var body: some View {
     NewReportView(
       onAddPhoto:    { },
       onAddLocation: { },
       onPublish:     { description, name, phone, isLost, imageUrl, lat, lng in
-        reportVm.saveReport(
+        reportVm.vm.saveReport(
           description: description,
           name:        name,
           phone:       phone,
@@ -1,11 +1,14 @@
 import SwiftUI
 import FirebaseCore
+import Shared
 
 
 class AppDelegate: NSObject, UIApplicationDelegate {
   func application(_ application: UIApplication,
     didFinishLaunchingWithOptions launchOptions: [UIApplication.LaunchOptionsKey : Any]? = nil) -> Bool {
     FirebaseApp.configure()
+    DatabaseModule.shared.doInit(factory: DatabaseDriverFactory())
+    CloudinaryTransport.companion.bridge = CloudinarySDKBridge()
 
     return true
   }
@@ -83,7 +83,7 @@ struct EditReportView: View {
                                 Image(uiImage: uiimg)
                                     .resizable()
                                     .scaledToFill()
-                            } else if !report.imageUrl.isEmpty, let url = URL(string: report.imageUrl) {
+                            } else if !report.imageUrl.isEmpty, let url = fullWidthImageURL(report.imageUrl, height: 220) {
                                 AsyncImage(url: url) { img in
                                     img.resizable().scaledToFill()
                                 } placeholder: {
@@ -102,7 +102,7 @@ struct EditReportView: View {
                         Group {
                             if let data = pickedImageData, let uiimg = UIImage(data: data) {
                                 Image(uiImage: uiimg).resizable().scaledToFill()
-                            } else if !report.imageUrl.isEmpty, let url = URL(string: report.imageUrl) {
+                            } else if !report.imageUrl.isEmpty, let url = fullWidthImageURL(report.imageUrl, height: 220) {
                                 AsyncImage(url: url) { img in img.resizable().scaledToFill() }
                                     placeholder: { Color.gray.opacity(0.2) }
                             } else {
@@ -220,7 +220,7 @@ struct EditReportView: View {
                             location:    nil,
                             lat:         latArg,
                             lng:         lngArg
-                        ) { error in
+                        ) { _, error in
                             if let error {
                                 print("Update failed: \(error)")
                             } else {
@@ -343,14 +343,3 @@ private struct LocationPickerView: View {
         .presentationDragIndicator(.visible)
     }
 }
-
-extension CloudinaryUploader {
-  static func upload(imageData data: Data) async throws -> String {
-    try await withCheckedThrowingContinuation { cont in
-      upload(data) { url in
-        if let url { cont.resume(returning: url) }
-        else { cont.resume(throwing: NSError(domain: "Cloudinary", code: -1)) }
-      }
-    }
-  }
-}
@@ -15,10 +15,21 @@ struct FeedView: View {
     @State private var isLocating = false
     @State private var locationError: String?
 
-    @State private var reports: [ReportModel] = []
+    @State private var pins = MapPins.empty
+    @State private var visibleBounds: GeoBounds?
+    @State private var visibleZoom: Double = 0
+    @State private var clusterIndex: MarkerClusterIndex<KotlinInt>?
+    @State private var clusters: [MarkerCluster<KotlinInt>] = []
+    @State private var pinsTruncated = false
+    @State private var pinsObservation: Shared.Observation?
     @State private var isLoadingReports = false
     @State private var reportsError: String?
 
+    // Loads the pins for the viewport and streams remote changes into the local
+    // cache while the feed is on screen
+    @StateObject private var reportVm = ReportViewModelHolder()
+    @State private var remoteChanges: Closeable?
+
     @State private var selectedReport: ReportModel? = nil
     @State private var showNewReport = false
 
@@ -30,31 +41,55 @@ struct FeedView: View {
                 Map(position: $cameraPosition) {
                     UserAnnotation()
 
-                    ForEach(reports, id: \.id) { rpt in
-                        let lat = rpt.lat
-                        let lng = rpt.lng
-                        if !lat.isNaN, !lng.isNaN {
-                            let coord = CLLocationCoordinate2D(latitude: lat, longitude: lng)
+                    ForEach(clusters, id: \.id) { cluster in
+                        let coord = CLLocationCoordinate2D(latitude: cluster.lat, longitude: cluster.lng)
+                        if let pin = cluster.item.map({ Int($0.int32Value) }) {
                             Annotation("", coordinate: coord) {
                                 VStack(spacing: 2) {
-                                    NavigationLink {
-                                        ReportDetailsView(report: rpt)
-                                            .navigationTitle("Report Details")
-                                            .navigationBarTitleDisplayMode(.inline)
+                                    Button {
+                                        openReport(id: pins.id(at: pin))
                                     } label: {
                                         Image(systemName: "mappin.circle.fill")
                                             .font(.title)
                                             .foregroundColor(.red)
                                             .shadow(radius: 2)
                                     }
-                                    Text(rpt.name.isEmpty ? (rpt.isLost ? "Lost" : "Found") : rpt.name)
+                                    let label = pins.label(at: pin)
+                                    Text(label.isEmpty ? (pins.isLost(at: pin) ? "Lost" : "Found") : label)
                                         .font(.caption2)
                                         .lineLimit(1)
                                 }
                             }
+                        } else {
+                            Annotation("", coordinate: coord) {
+                                Button {
+                                    zoom(into: cluster)
+                                } label: {
+                                    Text(pinsTruncated ? "\(cluster.count)+" : "\(cluster.count)")
+                                        .font(.caption.bold())
+                                        .foregroundColor(.white)
+                                        .frame(width: 36, height: 36)
+                                        .background(Circle().fill(Color.red))
+                                        .overlay(Circle().stroke(Color.white, lineWidth: 2))
+                                        .shadow(radius: 2)
+                                }
+                            }
                         }
                     }
                 }
+                // Every camera frame goes to the view model, which debounces, widens
+                // and caps the pin query; clusters are re-read once the camera rests.
+                .onMapCameraChange(frequency: .continuous) { context in
+                    reportVm.vm.onViewportChanged(
+                        bounds: geoBounds(of: context.region),
+                        zoom: zoomLevel(of: context.region)
+                    )
+                }
+                .onMapCameraChange(frequency: .onEnd) { context in
+                    visibleBounds = geoBounds(of: context.region)
+                    visibleZoom = zoomLevel(of: context.region)
+                    updateClusters()
+                }
                 .frame(maxWidth: .infinity)
                 .frame(maxHeight: .infinity)
                 .padding(.top, 32)
@@ -107,39 +142,121 @@ struct FeedView: View {
             .padding(.horizontal, 24)
             .padding(.bottom, 16)
         }
-        .onAppear { session.currentTitle = "Feed" }
+        .onAppear {
+            session.currentTitle = "Feed"
+            if remoteChanges == nil { remoteChanges = reportVm.vm.followRemoteChanges() }
+            if pinsObservation == nil { pinsObservation = observeMapPins() }
+        }
+        .onDisappear {
+            remoteChanges?.close()
+            remoteChanges = nil
+            pinsObservation?.close()
+            pinsObservation = nil
+        }
         .task {
-            if reports.isEmpty { reloadReports() }
+            if pins.count == 0 { reloadReports() }
             if userCoordinate == nil { locateMe() }
         }
         .navigationBarTitleDisplayMode(.inline)
         .sheet(isPresented: $showNewReport) {
             ReportsContainerView()
         }
+        .navigationDestination(item: $selectedReport) { rpt in
+            ReportDetailsView(report: rpt)
+                .navigationTitle("Report Details")
+                .navigationBarTitleDisplayMode(.inline)
+        }
     }
 
+    // Pulls remote changes into the local cache; the pin observation re-reads the
+    // visible area when the rows change.
     private func reloadReports() {
         guard !isLoadingReports else { return }
         isLoadingReports = true
         reportsError = nil
 
-        Shared.ReportRepositoryImpl().getAllReports { list, error in
+        reportVm.repository.refreshReports { error in
             DispatchQueue.main.async {
                 self.isLoadingReports = false
                 if let error = error {
                     self.reportsError = error.localizedDescription
-                    self.reports = []
-                    return
                 }
-                if let arr = list {
-                    self.reports = arr
-                } else {
-                    self.reports = []
+            }
+        }
+    }
+
+    // Pins for the current viewport arrive on the main thread as a columnar batch
+    // with its cluster index already built: a few buffers across the bridge instead
+    // of a ReportModel per pin, and no index work on the main queue.
+    private func observeMapPins() -> Shared.Observation {
+        reportVm.vm.observeMapPins { loaded in
+            self.pins = MapPins(loaded.pins)
+            self.clusterIndex = loaded.index
+            self.pinsTruncated = loaded.truncated
+            self.updateClusters()
+        }
+    }
+
+    // The full report is only read for the pin that was tapped.
+    private func openReport(id: String) {
+        reportVm.repository.getReport(id: id) { report, error in
+            DispatchQueue.main.async {
+                if let error = error {
+                    self.reportsError = error.localizedDescription
+                    return
                 }
+                self.selectedReport = report
             }
         }
     }
 
+    private func updateClusters() {
+        guard let index = clusterIndex, let bounds = visibleBounds else {
+            clusters = []
+            return
+        }
+        clusters = index.getClusters(bounds: bounds.expandedBy(fraction: 0.5), zoom: visibleZoom)
+    }
+
+    // Zoom in far enough for the cluster to break apart.
+    private func zoom(into cluster: MarkerCluster<KotlinInt>) {
+        let center = CLLocationCoordinate2D(latitude: cluster.lat, longitude: cluster.lng)
+        let lngDelta = 360 * Double(UIScreen.main.bounds.width) / (256 * pow(2, Double(cluster.expansionZoom)))
+        withAnimation {
+            cameraPosition = .region(
+                MKCoordinateRegion(
+                    center: center,
+                    span: MKCoordinateSpan(latitudeDelta: lngDelta, longitudeDelta: lngDelta)
+                )
+            )
+        }
+    }
+
+    // Web Mercator zoom of the region, comparable to Google Maps zoom levels.
+    private func zoomLevel(of region: MKCoordinateRegion) -> Double {
+        let lngDelta = max(region.span.longitudeDelta, 1e-9)
+        return log2(360 * Double(UIScreen.main.bounds.width) / (256 * lngDelta))
+    }
+
+    private func geoBounds(of region: MKCoordinateRegion) -> GeoBounds {
+        let halfLat = region.span.latitudeDelta / 2
+        let halfLng = region.span.longitudeDelta / 2
+        let south = max(region.center.latitude - halfLat, -90)
+        let north = min(region.center.latitude + halfLat, 90)
+        if halfLng >= 180 {
+            return GeoBounds(south: south, west: -180, north: north, east: 180)
+        }
+        func wrap(_ lng: Double) -> Double {
+            lng > 180 ? lng - 360 : (lng < -180 ? lng + 360 : lng)
+        }
+        return GeoBounds(
+            south: south,
+            west: wrap(region.center.longitude - halfLng),
+            north: north,
+            east: wrap(region.center.longitude + halfLng)
+        )
+    }
+
     private func locateMe() {
         guard !isLocating else { return }
         isLocating = true
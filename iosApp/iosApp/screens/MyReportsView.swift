@@ -95,7 +95,7 @@ struct ReportRow: View {
 
     var body: some View {
         HStack(spacing: 14) {
-            if !report.imageUrl.isEmpty, let url = URL(string: report.imageUrl) {
+            if !report.imageUrl.isEmpty, let url = sizedImageURL(report.imageUrl, width: 88, height: 88) {
                 AsyncImage(url: url) { img in img.resizable() } placeholder: {
                     Color.gray.opacity(0.2)
                 }
@@ -32,7 +32,7 @@ struct ReportDetailsView: View {
                 VStack(alignment: .leading, spacing: 8) {
 
                     // Image
-                    if !current.imageUrl.isEmpty, let url = URL(string: current.imageUrl) {
+                    if !current.imageUrl.isEmpty, let url = fullWidthImageURL(current.imageUrl, height: 200) {
                         AsyncImage(url: url) { img in
                             img.resizable().scaledToFill()
                         } placeholder: {
@@ -0,0 +1,11 @@
+import SwiftUI
+import Shared
+
+/// Keeps one shared `ReportViewModel` per view identity. SwiftUI rebuilds view
+/// structs on every parent render, so a `let` view model would be a new one each
+/// time, with its own repository and jobs; `@StateObject` creates this holder once.
+final class ReportViewModelHolder: ObservableObject {
+  let vm = ReportViewModel()
+  // For the one-off reads a view makes itself (refresh, the tapped report)
+  let repository = ReportRepositoryImpl()
+}
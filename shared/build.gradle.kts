@@ -5,6 +5,8 @@ plugins {
     alias(libs.plugins.kotlinMultiplatform)
     alias(libs.plugins.androidLibrary)
     alias(libs.plugins.kotlin.serialization)
+    alias(libs.plugins.kotlin.allopen)
+    alias(libs.plugins.kotlinx.benchmark)
     id("app.cash.sqldelight") version "2.0.2"
 
 }
@@ -18,6 +20,17 @@ kotlin {
         }
     }
 
+    // Not shipped: runs the shared code on build hosts for benchmarks (src/jvmBenchmark).
+    jvm {
+        compilations.create("benchmark") {
+            associateWith(this@jvm.compilations.getByName("main"))
+            defaultSourceSet.kotlin.srcDir("src/commonFakes/kotlin")
+            defaultSourceSet.dependencies {
+                implementation(libs.kotlinx.benchmark.runtime)
+            }
+        }
+    }
+
     listOf(
         iosX64(),
         iosArm64(),
@@ -43,6 +56,9 @@ kotlin {
             implementation("com.google.android.gms:play-services-location:21.3.0")
             implementation("androidx.room:room-runtime:2.6.1")
             implementation("androidx.room:room-ktx:2.6.1")
+            // Bundled SQLite: the framework build ships without the R*Tree module
+            implementation("com.github.requery:sqlite-android:3.45.0")
+            implementation(libs.cloudinary.android)
 
         }
         commonMain.dependencies {
@@ -50,6 +66,7 @@ kotlin {
             implementation("app.cash.sqldelight:coroutines-extensions:2.0.2")
             implementation(libs.sqldelight.runtime)
             implementation("org.jetbrains.kotlinx:kotlinx-coroutines-core:1.8.0")
+            implementation("org.jetbrains.kotlinx:atomicfu:0.23.2")
             implementation(project.dependencies.platform(libs.firebase.bom))
             implementation("org.jetbrains.kotlinx:kotlinx-datetime:0.6.0")
             implementation("dev.gitlive:firebase-app:2.1.0")
@@ -64,13 +81,21 @@ kotlin {
             implementation("dev.gitlive:firebase-firestore:1.13.1")
 
 
+        }
+        // In-memory stand-ins (e.g. FakeFirebaseRepository) for the tests and the benchmarks; never shipped.
+        commonTest {
+            kotlin.srcDir("src/commonFakes/kotlin")
         }
         commonTest.dependencies {
             implementation(libs.kotlin.test)
+            implementation("org.jetbrains.kotlinx:kotlinx-coroutines-test:1.8.0")
         }
         iosMain.dependencies {
             implementation("app.cash.sqldelight:native-driver:2.0.2")
         }
+        jvmMain.dependencies {
+            implementation("app.cash.sqldelight:sqlite-driver:2.0.2")
+        }
     }
 }
 
@@ -90,6 +115,38 @@ sqldelight {
         create("AppDatabase") {
             packageName.set("org.example.project.data.report")
             schemaOutputDirectory.set(file("src/commonMain/sqldelight/databases"))
+            // ON CONFLICT ... DO UPDATE in upsertReport
+            dialect("app.cash.sqldelight:sqlite-3-24-dialect:2.0.2")
+        }
+    }
+}
+
+// JMH needs open benchmark classes
+allOpen {
+    annotation("org.openjdk.jmh.annotations.State")
+}
+
+// ./gradlew :shared:benchmark, or :shared:smokeBenchmark for one small size.
+// Results land in shared/build/reports/benchmarks/<config>/<timestamp>/jvmBenchmark.json.
+benchmark {
+    targets {
+        register("jvmBenchmark")
+    }
+    configurations {
+        named("main") {
+            warmups = 3
+            iterations = 5
+            iterationTime = 1
+            iterationTimeUnit = "s"
+            reportFormat = "json"
+        }
+        register("smoke") {
+            warmups = 1
+            iterations = 2
+            iterationTime = 500
+            iterationTimeUnit = "ms"
+            reportFormat = "json"
+            param("size", 1000)
         }
     }
 }
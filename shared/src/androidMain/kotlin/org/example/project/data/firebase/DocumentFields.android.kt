@@ -0,0 +1,14 @@
+package org.example.project.data.firebase
+
+import com.google.firebase.Timestamp
+import dev.gitlive.firebase.firestore.DocumentSnapshot
+import dev.gitlive.firebase.firestore.android
+
+// The Android SDK already hands out Long/Double/String/Boolean; only timestamps need converting.
+internal actual fun DocumentSnapshot.rawFields(): Map<String, Any?> {
+    val data = android.data ?: return emptyMap()
+    if (data.values.none { it is Timestamp }) return data
+    return data.mapValues { (_, value) ->
+        if (value is Timestamp) value.seconds * 1000 + value.nanoseconds / 1_000_000 else value
+    }
+}
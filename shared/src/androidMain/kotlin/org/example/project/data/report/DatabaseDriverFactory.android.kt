@@ -2,9 +2,17 @@ package org.example.project.data.report
 
 import app.cash.sqldelight.db.SqlDriver
 import app.cash.sqldelight.driver.android.AndroidSqliteDriver
+import io.requery.android.database.sqlite.RequerySQLiteOpenHelperFactory
 import org.example.project.MyApp
 
 actual class DatabaseDriverFactory {
     actual fun createDriver(): SqlDriver =
-        AndroidSqliteDriver(AppDatabase.Schema, MyApp.ctx, "app.db")
-}
\ No newline at end of file
+        AndroidSqliteDriver(
+            schema = AppDatabase.Schema,
+            context = MyApp.ctx,
+            name = "app.db",
+            // reports_rtree needs SQLite's R*Tree module, which the framework SQLite lacks
+            factory = RequerySQLiteOpenHelperFactory(),
+            callback = AndroidSqliteDriver.Callback(AppDatabase.Schema, *ReportMigrations.callbacks)
+        )
+}
@@ -0,0 +1,45 @@
+package org.example.project.image
+
+import com.cloudinary.android.MediaManager
+import com.cloudinary.android.callback.ErrorInfo
+import com.cloudinary.android.callback.UploadCallback
+import kotlinx.coroutines.suspendCancellableCoroutine
+import java.io.IOException
+import kotlin.coroutines.resume
+import kotlin.coroutines.resumeWithException
+
+// MediaManager.init(...) must already have been called in MyApp.onCreate
+actual class CloudinaryTransport actual constructor() : UploadTransport {
+
+    actual override suspend fun send(
+        bytes: ByteArray,
+        onProgress: (sentBytes: Long, totalBytes: Long) -> Unit
+    ): String = suspendCancellableCoroutine { cont ->
+        val report = onProgress
+        val requestId = MediaManager.get().upload(bytes)
+            .option("resource_type", "image")
+            .callback(object : UploadCallback {
+                override fun onStart(requestId: String) = Unit
+                override fun onProgress(requestId: String, bytes: Long, totalBytes: Long) = report(bytes, totalBytes)
+                // Every resume is guarded: the continuation may already be done
+                // (cancelled, or failed by onReschedule) when a late callback arrives.
+                override fun onSuccess(requestId: String, resultData: Map<Any?, Any?>) {
+                    if (!cont.isActive) return
+                    val url = (resultData["secure_url"] ?: resultData["url"])?.toString()
+                    if (url != null) cont.resume(url)
+                    else cont.resumeWithException(IOException("Upload returned no URL"))
+                }
+                override fun onError(requestId: String, error: ErrorInfo) {
+                    if (cont.isActive) cont.resumeWithException(IOException("Upload failed: ${error.description}"))
+                }
+                // MediaManager reschedules on network errors; cancel its retry so the
+                // caller's own retry is the only one, and report the failure
+                override fun onReschedule(requestId: String, error: ErrorInfo) {
+                    MediaManager.get().cancelRequest(requestId)
+                    if (cont.isActive) cont.resumeWithException(IOException("Upload rescheduled: ${error.description}"))
+                }
+            })
+            .dispatch()
+        cont.invokeOnCancellation { MediaManager.get().cancelRequest(requestId) }
+    }
+}
@@ -0,0 +1,72 @@
+package org.example.project.image
+
+import android.content.Context
+import android.graphics.Bitmap
+import android.graphics.BitmapFactory
+import android.graphics.Matrix
+import android.media.ExifInterface
+import android.net.ConnectivityManager
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.withContext
+import java.io.ByteArrayOutputStream
+import java.io.IOException
+
+actual class ImagePreprocessor actual constructor(private val config: ImagePreprocessConfig) {
+
+    actual suspend fun preprocess(bytes: ByteArray): ByteArray = withContext(Dispatchers.Default) {
+        val bounds = BitmapFactory.Options().apply { inJustDecodeBounds = true }
+        BitmapFactory.decodeByteArray(bytes, 0, bytes.size, bounds)
+        if (bounds.outWidth <= 0 || bounds.outHeight <= 0) throw IOException("Not a decodable image")
+
+        val orientation = ExifInterface(bytes.inputStream())
+            .getAttributeInt(ExifInterface.TAG_ORIENTATION, ExifInterface.ORIENTATION_NORMAL)
+        val options = BitmapFactory.Options().apply {
+            inSampleSize = ImageSizing.sampleSize(bounds.outWidth, bounds.outHeight, config.maxEdgePx)
+        }
+        val sampled = BitmapFactory.decodeByteArray(bytes, 0, bytes.size, options)
+            ?: throw IOException("Not a decodable image")
+
+        val upright = scaleAndOrient(sampled, orientation)
+        try {
+            // Bitmap.compress writes no EXIF, so location and device tags are dropped too
+            ImageSizing.encodeWithinBudget(
+                config,
+                encode = { quality ->
+                    ByteArrayOutputStream().also { upright.compress(Bitmap.CompressFormat.JPEG, quality, it) }
+                        .toByteArray()
+                },
+                sizeOf = { it.size }
+            )
+        } finally {
+            upright.recycle()
+        }
+    }
+
+    private fun scaleAndOrient(bitmap: Bitmap, orientation: Int): Bitmap {
+        val (width, height) = ImageSizing.fit(bitmap.width, bitmap.height, config.maxEdgePx)
+        val matrix = Matrix().apply {
+            postScale(width.toFloat() / bitmap.width, height.toFloat() / bitmap.height)
+            when (orientation) {
+                ExifInterface.ORIENTATION_FLIP_HORIZONTAL -> postScale(-1f, 1f)
+                ExifInterface.ORIENTATION_ROTATE_180 -> postRotate(180f)
+                ExifInterface.ORIENTATION_FLIP_VERTICAL -> postScale(1f, -1f)
+                ExifInterface.ORIENTATION_TRANSPOSE -> { postRotate(90f); postScale(-1f, 1f) }
+                ExifInterface.ORIENTATION_ROTATE_90 -> postRotate(90f)
+                ExifInterface.ORIENTATION_TRANSVERSE -> { postRotate(-90f); postScale(-1f, 1f) }
+                ExifInterface.ORIENTATION_ROTATE_270 -> postRotate(270f)
+            }
+        }
+        if (matrix.isIdentity) return bitmap
+        return Bitmap.createBitmap(bitmap, 0, 0, bitmap.width, bitmap.height, matrix, true)
+            .also { if (it !== bitmap) bitmap.recycle() }
+    }
+
+    companion object {
+        /** [ImagePreprocessConfig.METERED] while the active network is metered. */
+        fun forCurrentNetwork(context: Context): ImagePreprocessor {
+            val connectivity = context.getSystemService(ConnectivityManager::class.java)
+            val metered = connectivity?.isActiveNetworkMetered ?: true
+            return ImagePreprocessor(if (metered) ImagePreprocessConfig.METERED else ImagePreprocessConfig.DEFAULT)
+        }
+    }
+}
@@ -0,0 +1,212 @@
+package org.example.project.data.firebase
+
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.MutableSharedFlow
+import kotlinx.coroutines.flow.onSubscription
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlinx.datetime.Clock
+import org.example.project.data.report.ReportChange
+import org.example.project.data.report.ReportModel
+import org.example.project.data.report.ReportWrite
+import kotlin.random.Random
+
+/**
+ * In-memory [FirebaseRepository] for tests and load tests: no network, one
+ * signed-in user, and a change stream that [generateLoad] can drive at thousands
+ * of events per second.
+ */
+class FakeFirebaseRepository(
+    private val uid: String = "fake-user",
+    private val clock: () -> Long = { Clock.System.now().toEpochMilliseconds() }
+) : FirebaseRepository {
+    private val mutex = Mutex()
+    private val reports = LinkedHashMap<String, ReportModel>()   // tombstones included
+    private val changes = MutableSharedFlow<List<ReportChange>>(extraBufferCapacity = 256)
+    private var nextId = 0L
+    private var lastStamp = 0L
+
+    override suspend fun signUp(email: String, password: String) {}
+    override suspend fun signIn(email: String, password: String) {}
+    override fun currentUserUid(): String? = uid
+    override suspend fun saveUserProfile(uid: String, email: String) {}
+    override suspend fun signOut() {}
+    override fun currentUserEmail(): String? = "$uid@example.com"
+    override suspend fun updatePassword(newPassword: String) {}
+
+    override suspend fun saveReport(
+        description: String,
+        name: String,
+        phone: String,
+        imageUrl: String,
+        isLost: Boolean,
+        location: String?,
+        lat: Double,
+        lng: Double
+    ): ReportModel {
+        val saved = mutex.withLock {
+            val now = stamp()
+            ReportModel(
+                id = "fake-${nextId++}",
+                userId = uid,
+                description = description,
+                name = name,
+                phone = phone,
+                imageUrl = imageUrl,
+                isLost = isLost,
+                location = location,
+                lat = lat,
+                lng = lng,
+                createdAt = now,
+                updatedAt = now
+            ).also { reports[it.id] = it }
+        }
+        changes.emit(listOf(ReportChange.Upserted(saved)))
+        return saved
+    }
+
+    override suspend fun getReportsForUser(userId: String): List<ReportModel> =
+        getAllReports().filter { it.userId == userId }
+
+    override suspend fun getAllReports(): List<ReportModel> = mutex.withLock {
+        reports.values.filterNot { it.deleted }.sortedByDescending { it.createdAt }
+    }
+
+    override suspend fun getReportChangesSince(updatedAfter: Long): List<ReportModel> = mutex.withLock {
+        reports.values.filter { it.updatedAt > updatedAfter }
+    }
+
+    // Subscribes before taking the initial snapshot, so no write can fall in between.
+    override fun observeReportChanges(updatedAfter: Long): Flow<List<ReportChange>> =
+        changes.onSubscription {
+            val initial = mutex.withLock {
+                reports.values.filter { it.updatedAt > updatedAfter }.map { it.toChange() }
+            }
+            if (initial.isNotEmpty()) emit(initial)
+        }
+
+    override suspend fun updateReport(
+        reportId: String,
+        description: String?,
+        name: String?,
+        phone: String?,
+        imageUrl: String?,
+        isLost: Boolean?,
+        location: String?,
+        lat: Double?,
+        lng: Double?
+    ) {
+        val updated = mutex.withLock {
+            val current = reports[reportId] ?: return
+            current.copy(
+                description = description ?: current.description,
+                name = name ?: current.name,
+                phone = phone ?: current.phone,
+                imageUrl = imageUrl ?: current.imageUrl,
+                isLost = isLost ?: current.isLost,
+                location = location ?: current.location,
+                lat = lat ?: current.lat,
+                lng = lng ?: current.lng,
+                updatedAt = stamp()
+            ).also { reports[reportId] = it }
+        }
+        changes.emit(listOf(ReportChange.Upserted(updated)))
+    }
+
+    override suspend fun deleteReport(reportId: String) {
+        val tombstone = mutex.withLock {
+            val current = reports[reportId] ?: return
+            current.copy(deleted = true, updatedAt = stamp()).also { reports[reportId] = it }
+        }
+        changes.emit(listOf(tombstone.toChange()))
+    }
+
+    override suspend fun writeReports(writes: List<ReportWrite>) {
+        if (writes.isEmpty()) return
+        val batch = mutex.withLock {
+            val now = stamp()
+            writes.mapNotNull { write ->
+                val current = reports[write.id]
+                val next = when (write) {
+                    is ReportWrite.Create -> write.report.copy(updatedAt = now)
+                    is ReportWrite.Update -> current?.let { write.patch.applyTo(it).copy(updatedAt = now) }
+                    is ReportWrite.Delete -> current?.copy(deleted = true, updatedAt = now)
+                } ?: return@mapNotNull null
+                reports[next.id] = next
+                next.toChange()
+            }
+        }
+        if (batch.isNotEmpty()) changes.emit(batch)
+    }
+
+    /** Stores [report] as given, `updatedAt` included: a write from another device with its own clock. */
+    suspend fun putRemote(report: ReportModel) {
+        mutex.withLock { reports[report.id] = report }
+        changes.emit(listOf(report.toChange()))
+    }
+
+    /**
+     * Emits [total] synthetic changes in batches of [batchSize]: inserts, edits of
+     * existing reports and a [deleteRatio] share of deletes, scattered around
+     * ([centerLat], [centerLng]). Runs as fast as the listener accepts batches, or
+     * paced to [eventsPerSecond] when that is positive.
+     */
+    suspend fun generateLoad(
+        total: Int,
+        batchSize: Int = 100,
+        eventsPerSecond: Int = 0,
+        deleteRatio: Double = 0.1,
+        centerLat: Double = 32.08,
+        centerLng: Double = 34.78,
+        random: Random = Random(42)
+    ) {
+        var sent = 0
+        while (sent < total) {
+            val size = minOf(batchSize, total - sent)
+            val batch = mutex.withLock {
+                val live = reports.values.filterNotTo(ArrayList()) { it.deleted }
+                List(size) {
+                    val roll = random.nextDouble()
+                    val pick = if (live.isNotEmpty() && roll < 0.5) random.nextInt(live.size) else -1
+                    val target = if (pick >= 0) live[pick] else null
+                    val now = stamp()
+                    val next = when {
+                        target == null -> ReportModel(
+                            id = "fake-${nextId++}",
+                            userId = uid,
+                            description = "Synthetic report $nextId",
+                            name = "Load $nextId",
+                            isLost = random.nextBoolean(),
+                            lat = centerLat + random.nextDouble(-0.2, 0.2),
+                            lng = centerLng + random.nextDouble(-0.2, 0.2),
+                            createdAt = now,
+                            updatedAt = now
+                        )
+                        roll < deleteRatio -> target.copy(deleted = true, updatedAt = now)
+                        else -> target.copy(description = "Edited at $now", updatedAt = now)
+                    }
+                    reports[next.id] = next
+                    when {
+                        target == null -> live += next
+                        next.deleted -> {
+                            val last = live.removeAt(live.size - 1)
+                            if (pick < live.size) live[pick] = last
+                        }
+                        else -> live[pick] = next
+                    }
+                    next.toChange()
+                }
+            }
+            changes.emit(batch)
+            sent += size
+            if (eventsPerSecond > 0) delay(size * 1000L / eventsPerSecond)
+        }
+    }
+
+    // Strictly increasing, so every write is visible to an `updatedAt > mark` query.
+    private fun stamp(): Long = maxOf(clock(), lastStamp + 1).also { lastStamp = it }
+
+    private fun ReportModel.toChange(): ReportChange =
+        if (deleted) ReportChange.Removed(id, updatedAt) else ReportChange.Upserted(this)
+}
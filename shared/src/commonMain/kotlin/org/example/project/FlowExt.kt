@@ -14,6 +14,10 @@ object IOScope {
 
 interface Closeable { fun close() }
 
+@Deprecated(
+    "Calls back on the main thread once per emission; observeLatest batches bursts",
+    ReplaceWith("observeLatest(ObserveOptions.UI, block)")
+)
 fun <T> StateFlow<T>.watch(block: (T) -> Unit): Closeable {
     val job = IOScope.scope.launch {
         collect { value -> block(value) }
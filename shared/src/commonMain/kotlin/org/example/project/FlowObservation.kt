@@ -0,0 +1,99 @@
+package org.example.project
+
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.channels.Channel
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.distinctUntilChanged
+import kotlinx.coroutines.flow.onEach
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.yield
+
+/**
+ * How [observe] hands a flow's values to its callback.
+ *
+ * - [conflate]: a batch carries only the newest value instead of everything
+ *   that arrived since the last delivery
+ * - [minIntervalMs]: at least this long between deliveries; values arriving
+ *   in between wait and go out together in the next batch
+ * - [distinct]: values equal to the one before them are dropped, and so is a
+ *   conflated batch equal to the last delivery
+ */
+data class ObserveOptions(
+    val conflate: Boolean = true,
+    val minIntervalMs: Long = 0,
+    val distinct: Boolean = true
+) {
+    companion object {
+        val DEFAULT = ObserveOptions()
+
+        // About two frames: enough to fold a burst of state changes into one redraw.
+        val UI = ObserveOptions(minIntervalMs = 32)
+    }
+}
+
+/**
+ * A running [observe]; [close] stops it. The counters are updated on the
+ * delivering thread (the main thread on iOS) and show how much a burst was
+ * folded: every value [received] is either [delivered] or [coalesced].
+ */
+class Observation internal constructor() : Closeable {
+    internal var job: Job? = null
+
+    var received = 0L
+        internal set
+    var delivered = 0L
+        internal set
+    var batches = 0L
+        internal set
+    val coalesced: Long get() = received - delivered
+
+    override fun close() {
+        job?.cancel()
+    }
+}
+
+/**
+ * Swift-facing observation of a flow, replacing one main-thread callback per
+ * emission with batches shaped by [options]. [onBatch] runs on the main thread
+ * with at least one value; the first value goes out at once.
+ */
+fun <T> Flow<T>.observe(options: ObserveOptions, onBatch: (List<T>) -> Unit): Observation =
+    observeIn(IOScope.scope, options, onBatch)
+
+/** [observe] delivering just the newest value of each batch. */
+fun <T> Flow<T>.observeLatest(options: ObserveOptions, onValue: (T) -> Unit): Observation =
+    observe(options.copy(conflate = true)) { onValue(it.last()) }
+
+internal fun <T> Flow<T>.observeIn(
+    scope: CoroutineScope,
+    options: ObserveOptions,
+    onBatch: (List<T>) -> Unit
+): Observation {
+    val observation = Observation()
+    val upstream = onEach { observation.received++ }
+        .let { if (options.distinct) it.distinctUntilChanged() else it }
+    observation.job = scope.launch {
+        val pending = Channel<T>(Channel.UNLIMITED)
+        launch { upstream.collect { pending.send(it) } }
+        var last: List<T>? = null
+        while (true) {
+            val batch = mutableListOf(pending.receive())
+            yield()   // let values that are already on their way join this batch
+            while (true) {
+                val next = pending.tryReceive()
+                if (next.isFailure) break
+                batch += next.getOrThrow()
+            }
+            val out = if (options.conflate) listOf(batch.last()) else batch
+            if (options.distinct && options.conflate && out == last) continue
+            observation.delivered += out.size
+            observation.batches++
+            last = out
+            onBatch(out)
+            if (options.minIntervalMs > 0) delay(options.minIntervalMs)
+        }
+    }
+    return observation
+}
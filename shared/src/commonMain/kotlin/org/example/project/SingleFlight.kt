@@ -0,0 +1,102 @@
+package org.example.project
+
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Deferred
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.NonCancellable
+import kotlinx.coroutines.async
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlinx.coroutines.withContext
+import kotlinx.datetime.Clock
+
+/**
+ * Request coalescing keyed by query: concurrent [get] calls for one key share a
+ * single in-flight coroutine and its result (or failure), and a successful result
+ * can be reused for a while after it completes.
+ *
+ * The shared work runs in [scope], not in any caller, so a caller that gives up
+ * does not cancel it for the others. Failures are never cached.
+ *
+ * Results are kept for at most [retainMs], whatever `maxAgeMs` later callers
+ * pass: a lookup that finds one expired drops it, and expired results of keys
+ * nobody asks for again are swept as new ones are stored, so arbitrary keys
+ * (bounds, search terms) do not pile up.
+ */
+class SingleFlight<K, V>(
+    private val scope: CoroutineScope,
+    private val retainMs: Long,
+    private val clock: () -> Long = { Clock.System.now().toEpochMilliseconds() }
+) {
+    private class Cached<V>(val value: V, val at: Long)
+
+    private val mutex = Mutex()
+    private val inFlight = HashMap<K, Deferred<V>>()
+    private val results = HashMap<K, Cached<V>>()
+    private var generation = 0L
+    private var sweepAt = MIN_SWEEP_SIZE
+
+    /**
+     * Result of [block] for [key]: a result completed less than [maxAgeMs] ago,
+     * else the call already running for the key, else a new one.
+     */
+    suspend fun get(key: K, maxAgeMs: Long = 0L, block: suspend () -> V): V {
+        val call = mutex.withLock {
+            results[key]?.let { cached ->
+                val age = clock() - cached.at
+                if (age < minOf(maxAgeMs, retainMs)) return cached.value
+                if (age >= retainMs) results.remove(key)
+            }
+            inFlight.getOrPut(key) { start(key, generation, block) }
+        }
+        return call.await()
+    }
+
+    /**
+     * Drops cached results for [key], or for every key when null. Calls already
+     * running keep their waiters but neither store their result nor take new ones.
+     */
+    suspend fun invalidate(key: K? = null) = mutex.withLock {
+        generation++
+        if (key == null) {
+            results.clear()
+            inFlight.clear()
+        } else {
+            results.remove(key)
+            inFlight.remove(key)
+        }
+    }
+
+    private fun start(key: K, startedIn: Long, block: suspend () -> V): Deferred<V> =
+        scope.async {
+            val self = coroutineContext[Job]
+            try {
+                block().also { value ->
+                    mutex.withLock {
+                        if (generation == startedIn) store(key, value)
+                    }
+                }
+            } finally {
+                withContext(NonCancellable) {
+                    mutex.withLock { if (inFlight[key] === self) inFlight.remove(key) }
+                }
+            }
+        }
+
+    // Under [mutex]. Sweeping only once the map has doubled keeps it amortised O(1) per store.
+    private fun store(key: K, value: V) {
+        val now = clock()
+        results[key] = Cached(value, now)
+        if (results.size >= sweepAt) {
+            results.values.removeAll { now - it.at >= retainMs }
+            sweepAt = maxOf(MIN_SWEEP_SIZE, 2 * results.size)
+        }
+    }
+
+    /** Results held right now, including expired ones not swept yet. */
+    internal val cachedCount: Int get() = results.size
+
+    private companion object {
+        const val MIN_SWEEP_SIZE = 64
+    }
+}
@@ -1,6 +1,9 @@
 package org.example.project.data.firebase
 
+import kotlinx.coroutines.flow.Flow
+import org.example.project.data.report.ReportChange
 import org.example.project.data.report.ReportModel
+import org.example.project.data.report.ReportWrite
 
 interface FirebaseRepository {
     suspend fun signUp(email: String, password: String)
@@ -10,10 +13,18 @@ interface FirebaseRepository {
     suspend fun signOut()
     fun currentUserEmail(): String?
     suspend fun updatePassword(newPassword: String)
-    suspend fun saveReport(description: String, name: String, phone: String, imageUrl: String, isLost: Boolean, location: String? = null, lat: Double, lng:Double )
+    // Returns the stored report, including its generated id.
+    suspend fun saveReport(description: String, name: String, phone: String, imageUrl: String, isLost: Boolean, location: String? = null, lat: Double, lng:Double ): ReportModel
     suspend fun getReportsForUser(userId: String): List<ReportModel>
     suspend fun getAllReports(): List<ReportModel>
+    // Every report (tombstones included) written strictly after `updatedAfter`.
+    suspend fun getReportChangesSince(updatedAfter: Long): List<ReportModel>
+    // Live stream of changes to reports written after `updatedAfter`: one list per snapshot,
+    // starting with everything already past the mark. Runs until the collector cancels.
+    fun observeReportChanges(updatedAfter: Long): Flow<List<ReportChange>>
     suspend fun updateReport(reportId: String, description: String? = null, name: String? = null, phone: String? = null, imageUrl: String? = null, isLost: Boolean? = null, location: String? = null, lat: Double? = null, lng: Double?=null)
     suspend fun deleteReport(reportId: String)
+    // Commits all writes atomically in one round trip, stamping `updatedAt` at commit time.
+    suspend fun writeReports(writes: List<ReportWrite>)
 }
 
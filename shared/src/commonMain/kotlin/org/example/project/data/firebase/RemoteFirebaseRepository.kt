@@ -4,7 +4,14 @@ package org.example.project.data.firebase
 import dev.gitlive.firebase.Firebase
 import dev.gitlive.firebase.auth.*
 import dev.gitlive.firebase.firestore.*
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.filter
+import kotlinx.coroutines.flow.map
+import kotlinx.datetime.Clock
+import org.example.project.data.report.ReportChange
 import org.example.project.data.report.ReportModel
+import org.example.project.data.report.ReportPatch
+import org.example.project.data.report.ReportWrite
 
 
 
@@ -60,14 +67,15 @@ class RemoteFirebaseRepository : FirebaseRepository {
         location: String?,
         lat: Double,
         lng: Double
-    ) {
+    ): ReportModel {
         // ① get the current user’s UID
         val userId = Firebase.auth.currentUser
             ?.uid
             ?: throw IllegalStateException("No authenticated user!")
 
         // ② write a document that includes userId
-        Firebase.firestore
+        val now = nowMillis()
+        val ref = Firebase.firestore
             .collection("reports")
             .add(
                 mapOf(
@@ -80,8 +88,25 @@ class RemoteFirebaseRepository : FirebaseRepository {
                     "location"    to location,
                     "lat"         to lat,
                     "lng"         to lng,
+                    "createdAt"   to now,
+                    "updatedAt"   to now,
                 )
             )
+
+        return ReportModel(
+            id = ref.id,
+            userId = userId,
+            description = description,
+            name = name,
+            phone = phone,
+            imageUrl = imageUrl,
+            isLost = isLost,
+            location = location,
+            lat = lat,
+            lng = lng,
+            createdAt = now,
+            updatedAt = now
+        )
     }
 
     // shared RemoteFirebaseRepository
@@ -92,65 +117,55 @@ class RemoteFirebaseRepository : FirebaseRepository {
             // .orderBy("createdAt", Direction.DESCENDING)   // TEMPORARILY DISABLE
             .get()
 
-        val results = mutableListOf<ReportModel>()
-        for (doc in snapshot.documents) {
-            try {
-                val m = doc.data(ReportModel.serializer()).copy(id = doc.id)
-                results += m
-            } catch (e: Exception) {
-                val raw = try { doc.data() as? Map<String, Any?> ?: emptyMap() } catch (_: Throwable) { emptyMap() }
-                results += ReportModel(
-                    id          = doc.id,
-                    userId      = raw["userId"]?.toString().orEmpty(),
-                    description = raw["description"]?.toString().orEmpty(),
-                    name        = raw["name"]?.toString().orEmpty(),
-                    phone       = raw["phone"]?.toString().orEmpty(),
-                    imageUrl    = raw["imageUrl"]?.toString().orEmpty(),
-                    isLost      = (raw["isLost"] as? Boolean) ?: false,
-                    location    = raw["location"]?.toString(),
-                    createdAt   = (raw["createdAt"] as? Number)?.toLong() ?: 0L
-                )
-            }
-        }
-
         // newest first on client
-        return results.sortedByDescending { it.createdAt }
+        return snapshot.documents
+            .map(::decodeReport)
+            .filterNot { it.deleted }
+            .sortedByDescending { it.createdAt }
     }
     override suspend fun getAllReports(): List<ReportModel> {
         val snapshot = Firebase.firestore
             .collection("reports")
             .get()
 
-        fun anyToDouble(v: Any?): Double = when (v) {
-            is Number -> v.toDouble()
-            is String -> v.toDoubleOrNull() ?: Double.NaN
-            else      -> Double.NaN
-        }
+        return snapshot.documents
+            .map(::decodeReport)
+            .filterNot { it.deleted }
+            .sortedByDescending { it.createdAt }
+    }
 
-        val results = mutableListOf<ReportModel>()
-        for (doc in snapshot.documents) {
-            try {
-                val m = doc.data(ReportModel.serializer()).copy(id = doc.id)
-                results += m
-            } catch (_: Exception) {
-                val raw = try { doc.data() as? Map<String, Any?> ?: emptyMap() } catch (_: Throwable) { emptyMap() }
-                results += ReportModel(
-                    id          = doc.id,
-                    userId      = raw["userId"]?.toString().orEmpty(),
-                    description = raw["description"]?.toString().orEmpty(),
-                    name        = raw["name"]?.toString().orEmpty(),
-                    phone       = raw["phone"]?.toString().orEmpty(),
-                    imageUrl    = raw["imageUrl"]?.toString().orEmpty(),
-                    isLost      = (raw["isLost"] as? Boolean) ?: false,
-                    location    = raw["location"]?.toString(),
-                    createdAt   = (raw["createdAt"] as? Number)?.toLong() ?: 0L,
-                    lat         = anyToDouble(raw["lat"]),
-                    lng         = anyToDouble(raw["lng"])
-                )
-            }
-        }
-        return results.sortedByDescending { it.createdAt }
+    override suspend fun getReportChangesSince(updatedAfter: Long): List<ReportModel> {
+        // documents without `updatedAt` (written before delta sync) never match;
+        // they arrive through the initial full snapshot instead
+        val snapshot = Firebase.firestore
+            .collection("reports")
+            .where { "updatedAt" greaterThan updatedAfter }
+            .get()
+
+        return snapshot.documents.map(::decodeReport)
     }
+
+    override fun observeReportChanges(updatedAfter: Long): Flow<List<ReportChange>> =
+        Firebase.firestore
+            .collection("reports")
+            .where { "updatedAt" greaterThan updatedAfter }
+            .snapshots
+            .map { snapshot ->
+                snapshot.documentChanges.map { change ->
+                    when (change.type) {
+                        ChangeType.REMOVED -> ReportChange.Removed(change.document.id)
+                        else -> {
+                            val report = decodeReport(change.document)
+                            if (report.deleted) ReportChange.Removed(report.id, report.updatedAt)
+                            else ReportChange.Upserted(report)
+                        }
+                    }
+                }
+            }
+            .filter { it.isNotEmpty() }
+
+    private fun decodeReport(doc: DocumentSnapshot): ReportModel = ReportDocumentDecoder.decode(doc)
+
   override suspend fun updateReport(
         reportId: String,
         description: String?,
@@ -175,6 +190,7 @@ class RemoteFirebaseRepository : FirebaseRepository {
 
 
       if (data.isEmpty()) return // nothing to update
+        data["updatedAt"] = nowMillis()
 
         Firebase.firestore
             .collection("reports")
@@ -183,10 +199,68 @@ class RemoteFirebaseRepository : FirebaseRepository {
     }
 
     override suspend fun deleteReport(reportId: String) {
+        // tombstone instead of a hard delete so delta sync can propagate it
         Firebase.firestore
             .collection("reports")
             .document(reportId)
-            .delete()
+            .update(
+                mapOf(
+                    "deleted"   to true,
+                    "updatedAt" to nowMillis()
+                )
+            )
     }
 
+    override suspend fun writeReports(writes: List<ReportWrite>) {
+        if (writes.isEmpty()) return
+        val reports = Firebase.firestore.collection("reports")
+        val now = nowMillis()
+        val batch = Firebase.firestore.batch()
+        // set/merge rather than add/update: the ids are chosen on the device, so a
+        // replayed batch overwrites its own earlier attempt instead of failing
+        writes.forEach { write ->
+            val doc = reports.document(write.id)
+            when (write) {
+                is ReportWrite.Create -> with(write.report) {
+                    batch.set(
+                        doc,
+                        mapOf(
+                            "userId"      to userId,
+                            "description" to description,
+                            "name"        to name,
+                            "phone"       to phone,
+                            "imageUrl"    to imageUrl,
+                            "isLost"      to isLost,
+                            "location"    to location,
+                            "lat"         to lat,
+                            "lng"         to lng,
+                            "createdAt"   to createdAt,
+                            "updatedAt"   to now,
+                        )
+                    )
+                }
+                is ReportWrite.Update ->
+                    batch.set(doc, write.patch.toFields() + ("updatedAt" to now), merge = true)
+                is ReportWrite.Delete ->
+                    batch.set(doc, mapOf("deleted" to true, "updatedAt" to now), merge = true)
+            }
+        }
+        batch.commit()
+    }
+
+    private fun ReportPatch.toFields(): Map<String, Any> {
+        val data = mutableMapOf<String, Any>()
+        description?.let { data["description"] = it }
+        name?.let        { data["name"]        = it }
+        phone?.let       { data["phone"]       = it }
+        imageUrl?.let    { data["imageUrl"]    = it }
+        isLost?.let      { data["isLost"]      = it }
+        location?.let    { data["location"]    = it }
+        lat?.let         { data["lat"]         = it }
+        lng?.let         { data["lng"]         = it }
+        return data
+    }
+
+    private fun nowMillis(): Long = Clock.System.now().toEpochMilliseconds()
+
 }
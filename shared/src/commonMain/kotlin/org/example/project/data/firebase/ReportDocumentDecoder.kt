@@ -0,0 +1,97 @@
+package org.example.project.data.firebase
+
+import dev.gitlive.firebase.firestore.DocumentSnapshot
+import org.example.project.data.report.ReportModel
+
+/**
+ * A document's fields as plain Kotlin values: strings, Booleans, Longs, Doubles,
+ * and Firestore timestamps as epoch millis. Nested maps and lists pass through as-is.
+ */
+internal expect fun DocumentSnapshot.rawFields(): Map<String, Any?>
+
+/**
+ * Decodes report documents in one pass over their fields, for clean and legacy
+ * documents alike. Legacy writes stored numbers as strings (or strings as numbers)
+ * and omitted fields added later; every field is coerced to the model's type, and
+ * anything missing or unusable falls back to the model's default. Never throws.
+ */
+object ReportDocumentDecoder {
+
+    fun decode(doc: DocumentSnapshot): ReportModel = decode(doc.id, doc.rawFields())
+
+    fun decode(id: String, fields: Map<String, Any?>): ReportModel {
+        var userId = ""
+        var description = ""
+        var name = ""
+        var phone = ""
+        var imageUrl = ""
+        var isLost = false
+        var location: String? = null
+        var lat = Double.NaN
+        var lng = Double.NaN
+        var createdAt = 0L
+        var updatedAt = 0L
+        var deleted = false
+
+        for ((key, value) in fields) {
+            when (key) {
+                "userId" -> userId = value.asString().orEmpty()
+                "description" -> description = value.asString().orEmpty()
+                "name" -> name = value.asString().orEmpty()
+                "phone" -> phone = value.asString().orEmpty()
+                "imageUrl" -> imageUrl = value.asString().orEmpty()
+                "isLost" -> isLost = value.asBoolean()
+                "location" -> location = value.asString()
+                "lat" -> lat = value.asDouble()
+                "lng" -> lng = value.asDouble()
+                "createdAt" -> createdAt = value.asLong()
+                "updatedAt" -> updatedAt = value.asLong()
+                "deleted" -> deleted = value.asBoolean()
+            }
+        }
+
+        return ReportModel(
+            id = id,
+            userId = userId,
+            description = description,
+            name = name,
+            phone = phone,
+            imageUrl = imageUrl,
+            isLost = isLost,
+            location = location,
+            lat = lat,
+            lng = lng,
+            createdAt = createdAt,
+            updatedAt = updatedAt,
+            deleted = deleted
+        )
+    }
+
+    private fun Any?.asString(): String? = when (this) {
+        is String -> this
+        is Number, is Boolean -> toString()
+        else -> null
+    }
+
+    private fun Any?.asDouble(): Double = when (this) {
+        is Double -> this
+        is Number -> toDouble()
+        is String -> trim().toDoubleOrNull() ?: Double.NaN
+        else -> Double.NaN
+    }
+
+    private fun Any?.asLong(): Long = when (this) {
+        is Long -> this
+        is Double -> if (isFinite()) toLong() else 0L
+        is Number -> toLong()
+        is String -> trim().let { it.toLongOrNull() ?: it.toDoubleOrNull()?.takeIf(Double::isFinite)?.toLong() } ?: 0L
+        else -> 0L
+    }
+
+    private fun Any?.asBoolean(): Boolean = when (this) {
+        is Boolean -> this
+        is Number -> toInt() != 0
+        is String -> equals("true", ignoreCase = true) || this == "1"
+        else -> false
+    }
+}
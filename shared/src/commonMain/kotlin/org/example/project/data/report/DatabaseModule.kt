@@ -2,10 +2,23 @@ package org.example.project.data.report
 
 import app.cash.sqldelight.coroutines.asFlow
 import app.cash.sqldelight.coroutines.mapToList
+import app.cash.sqldelight.coroutines.mapToOneOrNull
 import kotlinx.coroutines.CoroutineDispatcher
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.flow
+import kotlinx.coroutines.flow.flowOn
+import kotlinx.coroutines.flow.map
+import kotlinx.serialization.json.Json
+import org.example.project.geo.GeoBounds
+import org.example.project.geo.Geohash
+import org.example.project.geo.MAX_DISTANCE_M
+import org.example.project.geo.boundsAround
+import org.example.project.geo.haversineMeters
 import kotlin.concurrent.Volatile
+import kotlin.math.PI
+import kotlin.math.abs
+import kotlin.math.cos
 
 object DatabaseModule {
     @Volatile
@@ -14,6 +27,7 @@ object DatabaseModule {
     fun init(factory: DatabaseDriverFactory) {
         if (_db == null) {
             _db = AppDatabase(factory.createDriver())
+            ReportOutbox.shared.start()
         }
     }
 
@@ -26,13 +40,176 @@ class LocalReportDataSource(
     private val io: CoroutineDispatcher = Dispatchers.Default
 ) {
     private val q get() = db.reportQueries
+    private val sync get() = db.syncStateQueries
+    private val outbox get() = db.outboxQueries
     fun observeAll(): Flow<List<Reports>> =
         q.selectAll().asFlow().mapToList(io)
 
+    fun observeByUser(userId: String): Flow<List<Reports>> =
+        q.selectByUser(userId).asFlow().mapToList(io)
+
     fun getAll(): List<Reports> = q.selectAll().executeAsList()
     fun getByUser(userId: String): List<Reports> =
         q.selectByUser(userId).executeAsList()
 
+    fun getById(id: String): ReportModel? = q.selectById(id).executeAsOneOrNull()?.toModel()
+
+    // Emits the row now and after every change to it; null once it is gone.
+    fun observeById(id: String): Flow<ReportModel?> =
+        q.selectById(id).asFlow().mapToOneOrNull(io).map { it?.toModel() }
+
+    fun countAll(): Long = q.countAll().executeAsOne()
+    fun countByUser(userId: String): Long = q.countByUser(userId).executeAsOne()
+
+    /**
+     * One keyset page, newest first: all reports, or only [userId]'s. Pass the
+     * previous page's [Page.next] as [after] to continue.
+     */
+    fun getPage(userId: String? = null, after: PageKey? = null, pageSize: Int = DEFAULT_PAGE_SIZE): Page<ReportModel> {
+        val afterCreatedAt = after?.createdAt ?: Long.MAX_VALUE
+        val afterId = after?.id ?: ""
+        val limit = pageSize.toLong()
+        val rows = if (userId == null) {
+            q.selectPageAll(afterCreatedAt, afterId, limit).executeAsList()
+        } else {
+            q.selectPageByUser(userId, afterCreatedAt, afterId, limit).executeAsList()
+        }
+        val next = rows.lastOrNull()
+            ?.takeIf { rows.size == pageSize }
+            ?.let { PageKey(it.createdAt, it.id) }
+        return Page(rows.map { it.toModel() }, next)
+    }
+
+    /**
+     * Cold flow of successive pages. Each page is only read once the collector has
+     * taken the previous one, so a slow consumer pulls pages on demand.
+     */
+    fun pages(userId: String? = null, pageSize: Int = DEFAULT_PAGE_SIZE): Flow<Page<ReportModel>> = flow {
+        var after: PageKey? = null
+        do {
+            val page = getPage(userId, after, pageSize)
+            emit(page)
+            after = page.next
+        } while (after != null)
+    }.flowOn(io)
+
+    // Emits on subscription and after every write to the user's rows.
+    fun observeChangesByUser(userId: String): Flow<Unit> =
+        q.countByUser(userId).asFlow().map { }
+
+    /** Up to [limit] newest reports inside [bounds], answered from the `reports_rtree` index. */
+    fun getInBounds(bounds: GeoBounds, limit: Long = Long.MAX_VALUE): List<Reports> {
+        val boxes = bounds.splitAtAntimeridian()
+        val rows = boxes.flatMap { box ->
+            q.selectInBox(box.south, box.north, box.west, box.east, limit).executeAsList()
+        }
+        return if (boxes.size == 1) rows
+        else rows.sortedByDescending { it.createdAt }.take(limit.coerceAtMost(Int.MAX_VALUE.toLong()).toInt())
+    }
+
+    /**
+     * [getInBounds] as a [MapPinBatch], read straight into its columns without a row
+     * object per report. When [bounds] crosses the antimeridian its two sides are
+     * read in turn, the second filling what is left of [limit].
+     */
+    fun getPinsInBounds(bounds: GeoBounds, limit: Long = Long.MAX_VALUE): MapPinBatch {
+        val pins = MapPinBatch.Builder()
+        var left = limit
+        for (box in bounds.splitAtAntimeridian()) {
+            if (left <= 0) break
+            // the mapper appends each row to the columns; the returned list only holds Units
+            val read = q.selectPinsInBox(box.south, box.north, box.west, box.east, left) { id, lat, lng, isLost, name, imageUrl ->
+                pins.add(id, lat!!, lng!!, isLost, name, imageUrl)
+            }.executeAsList().size
+            left -= read
+        }
+        return pins.build()
+    }
+
+    fun countInBounds(bounds: GeoBounds): Long =
+        bounds.splitAtAntimeridian().sumOf { box ->
+            q.countInBox(box.south, box.north, box.west, box.east).executeAsOne()
+        }
+
+    /**
+     * Up to [limit] reports closest to ([lat], [lng]) among those inside [searchBox],
+     * nearest first. Distances are equirectangular, which is accurate at map scale.
+     */
+    fun getNearestInBox(lat: Double, lng: Double, searchBox: GeoBounds, limit: Long): List<Reports> {
+        val lngScale = cos(lat * PI / 180.0)
+        val boxes = searchBox.splitAtAntimeridian()
+        val rows = boxes.flatMap { box ->
+            // Shift the query point by a full turn when that brings it closer to the
+            // box, so the SQL ordering matches the wrapped distance.
+            val center = (box.west + box.east) / 2
+            val queryLng = listOf(lng, lng - 360.0, lng + 360.0).minBy { abs(it - center) }
+            q.selectNearestInBox(box.south, box.north, box.west, box.east, lat, queryLng, lngScale, limit)
+                .executeAsList()
+        }
+        return if (boxes.size == 1) rows
+        else rows.sortedBy { it.distanceSq(lat, lng, lngScale) }.take(limit.toInt())
+    }
+
+    /**
+     * Up to [k] reports within [maxRadiusMeters] of ([lat], [lng]), nearest first by
+     * great-circle distance.
+     *
+     * Searches a circle that starts at [NEAREST_START_RADIUS_M] and doubles until it
+     * holds [k] reports or reaches [maxRadiusMeters]. Each step first counts the
+     * `reports_rtree` entries in the circle's bounding box, which reads no rows, so
+     * sparse areas grow the circle cheaply. Only once the box holds enough are rows
+     * read: the closest few by the index's equirectangular order, re-ranked and cut
+     * at the radius with haversine.
+     */
+    fun getNearest(lat: Double, lng: Double, k: Int, maxRadiusMeters: Double): List<NearbyReport> {
+        if (k <= 0) return emptyList()
+        val maxRadius = maxRadiusMeters.coerceAtMost(MAX_DISTANCE_M)
+        var radius = NEAREST_START_RADIUS_M.coerceAtMost(maxRadius)
+        while (true) {
+            val box = boundsAround(lat, lng, radius)
+            val last = radius >= maxRadius
+            if (last || countInBounds(box) >= k) {
+                // equirectangular and haversine order can disagree on near ties, so
+                // read more candidates than needed before re-ranking
+                val hits = getNearestInBox(lat, lng, box, k * NEAREST_OVERFETCH.toLong())
+                    .mapNotNull { row ->
+                        // rows in the R*Tree always have coordinates
+                        val distance = haversineMeters(lat, lng, row.lat!!, row.lng!!)
+                        if (distance <= radius) NearbyReport(row.toModel(), distance) else null
+                    }
+                    .sortedBy { it.distanceMeters }
+                    .take(k)
+                // the box's corners lie outside the circle, so it may hold k reports
+                // while the circle does not yet
+                if (hits.size == k || last) return hits
+            }
+            radius = (radius * 2).coerceAtMost(maxRadius)
+        }
+    }
+
+    /**
+     * Best-ranked reports whose description, name or location contain words
+     * starting with the words of [query].
+     */
+    fun search(query: String, limit: Int = DEFAULT_SEARCH_LIMIT): List<ReportModel> {
+        val match = ReportSearch.toMatchQuery(query) ?: return emptyList()
+        return q.search(match, limit.toLong()).executeAsList().map { it.toModel() }
+    }
+
+    fun getByGeohashPrefix(prefix: String): List<Reports> =
+        q.selectByGeohashPrefix(prefix).executeAsList()
+
+    // Re-runs the indexed lookup whenever the reports table changes.
+    fun observeInBounds(bounds: GeoBounds, limit: Long = Long.MAX_VALUE): Flow<List<Reports>> =
+        q.countAll().asFlow()
+            .map { getInBounds(bounds, limit) }
+            .flowOn(io)
+
+    fun observePinsInBounds(bounds: GeoBounds, limit: Long = Long.MAX_VALUE): Flow<MapPinBatch> =
+        q.countAll().asFlow()
+            .map { getPinsInBounds(bounds, limit) }
+            .flowOn(io)
+
     fun upsert(model: ReportModel) {
         q.upsertReport(
             id = model.id,
@@ -43,18 +220,180 @@ class LocalReportDataSource(
             imageUrl = model.imageUrl,
             isLost = model.isLost,
             location = model.location,
-            lat = model.lat,
-            lng = model.lng,
-            createdAt = model.createdAt
+            lat = model.lat.takeUnless { it.isNaN() },
+            lng = model.lng.takeUnless { it.isNaN() },
+            createdAt = model.createdAt,
+            geohash = model.geohash()
         )
     }
 
     fun replaceAllForUser(userId: String, items: List<ReportModel>) {
         db.transaction {
-
+            q.deleteByUser(userId)
             items.forEach { upsert(it) }
         }
     }
 
     fun deleteById(id: String) = q.deleteReport(id)
+
+    fun highWaterMark(collection: String): Long? =
+        sync.selectHighWaterMark(collection).executeAsOneOrNull()
+
+    /** Stores a new report and queues its creation in the outbox. */
+    fun saveLocally(model: ReportModel, now: Long) {
+        db.transaction {
+            upsert(model)
+            outbox.insertEntry(model.id, OP_CREATE, null, now)
+        }
+    }
+
+    /**
+     * Applies [patch] to the cached row and queues it, folded into whatever write is
+     * already pending for the report. Returns the updated row, or null when the
+     * report is not cached (the patch is queued regardless).
+     */
+    fun updateLocally(id: String, patch: ReportPatch, now: Long): ReportModel? =
+        db.transactionWithResult {
+            val updated = getById(id)?.let { patch.applyTo(it) }?.also { upsert(it) }
+            val pending = outbox.selectEntry(id).executeAsOneOrNull()
+            when (pending?.op) {
+                null -> outbox.insertEntry(id, OP_UPDATE, json.encodeToString(ReportPatch.serializer(), patch), now)
+                // a pending create sends the row as it is at flush time
+                OP_CREATE -> outbox.foldEntry(OP_CREATE, null, id)
+                OP_UPDATE -> {
+                    val merged = pending.decodePatch().then(patch)
+                    outbox.foldEntry(OP_UPDATE, json.encodeToString(ReportPatch.serializer(), merged), id)
+                }
+                else -> Unit   // already deleted
+            }
+            updated
+        }
+
+    /** Drops the cached row and queues the delete. */
+    fun deleteLocally(id: String, now: Long) {
+        db.transaction {
+            q.deleteReport(id)
+            val pending = outbox.selectEntry(id).executeAsOneOrNull()
+            when {
+                pending == null -> outbox.insertEntry(id, OP_DELETE, null, now)
+                // never sent, so the server has nothing to delete
+                pending.op == OP_CREATE && pending.attempts == 0L -> outbox.deleteEntry(id)
+                else -> outbox.foldEntry(OP_DELETE, null, id)
+            }
+        }
+    }
+
+    /**
+     * Claims up to [limit] entries due at [now] for one flush. Claiming counts as an
+     * attempt, so a delete folded into a claimed create is still sent.
+     */
+    // Claimed entries are leased for [OUTBOX_LEASE_MS], so a second sender never takes them too.
+    fun claimOutbox(now: Long, limit: Int): List<OutboxClaim> =
+        db.transactionWithResult {
+            outbox.selectDue(now, limit.toLong()).executeAsList().mapNotNull { entry ->
+                val write = when (entry.op) {
+                    OP_CREATE -> getById(entry.reportId)?.let { ReportWrite.Create(it) }
+                    OP_UPDATE -> ReportWrite.Update(entry.reportId, entry.decodePatch())
+                    else -> ReportWrite.Delete(entry.reportId)
+                }
+                if (write == null) {
+                    outbox.deleteEntry(entry.reportId)   // created and removed before any flush
+                    return@mapNotNull null
+                }
+                outbox.claimEntry(leaseUntil = now + OUTBOX_LEASE_MS, reportId = entry.reportId, version = entry.version)
+                OutboxClaim(write, entry.version, entry.attempts + 1)
+            }
+        }
+
+    // Entries folded since they were claimed keep their row and are sent again.
+    fun acknowledgeOutbox(claims: List<OutboxClaim>) {
+        db.transaction {
+            claims.forEach { outbox.acknowledgeEntry(it.write.id, it.version) }
+        }
+    }
+
+    fun retryOutbox(claims: List<OutboxClaim>, error: String?, nextAttemptAt: (OutboxClaim) -> Long) {
+        db.transaction {
+            claims.forEach { outbox.retryEntry(nextAttemptAt(it), error, it.write.id, it.version) }
+        }
+    }
+
+    fun nextOutboxAttemptAt(): Long? = outbox.selectNextAttemptAt().executeAsOne().nextAttemptAt
+
+    fun countPendingWrites(): Long = outbox.countPending().executeAsOne()
+
+    /**
+     * Applies a batch of remote changes and advances the watermark atomically, so an
+     * interrupted sync never leaves the mark ahead of the rows it describes.
+     * A [fullSnapshot] replaces the table instead of merging into it. Reports with a
+     * write still in the outbox keep their local state until it is acknowledged.
+     */
+    fun mergeChanges(
+        collection: String,
+        changes: List<ReportModel>,
+        highWaterMark: Long,
+        fullSnapshot: Boolean = false
+    ) {
+        db.transaction {
+            val pending = outbox.selectPendingIds().executeAsList().toHashSet()
+            if (fullSnapshot) q.deleteAllSynced()
+            changes.forEach { change ->
+                if (change.id in pending) return@forEach
+                if (change.deleted) q.deleteReport(change.id) else upsert(change)
+            }
+            sync.upsertHighWaterMark(collection, highWaterMark)
+        }
+    }
+
+    /**
+     * Applies live listener events in one transaction and advances the watermark;
+     * like [mergeChanges], it leaves reports with pending local writes alone.
+     */
+    fun applyChanges(collection: String, changes: List<ReportChange>, highWaterMark: Long) {
+        db.transaction {
+            val pending = outbox.selectPendingIds().executeAsList().toHashSet()
+            changes.forEach { change ->
+                if (change.id in pending) return@forEach
+                when (change) {
+                    is ReportChange.Upserted -> upsert(change.report)
+                    is ReportChange.Removed -> q.deleteReport(change.id)
+                }
+            }
+            sync.upsertHighWaterMark(collection, highWaterMark)
+        }
+    }
+
+    fun resetSync(collection: String) = sync.clearHighWaterMark(collection)
+
+    companion object {
+        const val DEFAULT_PAGE_SIZE = 30
+        const val DEFAULT_SEARCH_LIMIT = 20
+        const val DEFAULT_NEAREST_K = 20
+        const val DEFAULT_NEAREST_RADIUS_M = 50_000.0
+
+        // well past a Firestore batch commit; a sender that died mid-flight is retried after it
+        const val OUTBOX_LEASE_MS = 60_000L
+
+        // a few city blocks: usually enough in town, a handful of doublings otherwise
+        private const val NEAREST_START_RADIUS_M = 500.0
+        private const val NEAREST_OVERFETCH = 2
+
+        private const val OP_CREATE = "create"
+        private const val OP_UPDATE = "update"
+        private const val OP_DELETE = "delete"
+        private val json = Json { ignoreUnknownKeys = true }
+    }
+
+    private fun Outbox.decodePatch(): ReportPatch =
+        patch?.let { json.decodeFromString(ReportPatch.serializer(), it) } ?: ReportPatch()
+
+    private fun Reports.distanceSq(lat: Double, lng: Double, lngScale: Double): Double {
+        val dLat = (this.lat ?: return Double.MAX_VALUE) - lat
+        var dLng = abs((this.lng ?: return Double.MAX_VALUE) - lng)
+        if (dLng > 180.0) dLng = 360.0 - dLng
+        return dLat * dLat + dLng * dLng * lngScale * lngScale
+    }
+
+    private fun ReportModel.geohash(): String? =
+        if (lat.isNaN() || lng.isNaN()) null else Geohash.encode(lat, lng)
 }
\ No newline at end of file
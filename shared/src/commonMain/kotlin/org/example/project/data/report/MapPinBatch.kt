@@ -0,0 +1,92 @@
+package org.example.project.data.report
+
+/**
+ * Map pins in columns: one array per field instead of one [ReportModel] per pin,
+ * so handing thousands of pins to Swift costs four buffers rather than an
+ * Objective-C object (and its retain and GC traffic) per report.
+ *
+ * Pin `i` sits at `coordinates[2i]` (lat), `coordinates[2i + 1]` (lng) and has
+ * the bits of `flags[i]` ([LOST], [HAS_IMAGE]). Its id, label and image URL are
+ * UTF-8 in [strings], in that order: string `s` of pin `i` spans
+ * `stringOffsets[3i + s] until stringOffsets[3i + s + 1]`.
+ */
+class MapPinBatch internal constructor(
+    val size: Int,
+    val coordinates: DoubleArray,
+    val flags: ByteArray,
+    val strings: ByteArray,
+    val stringOffsets: IntArray
+) {
+    fun lat(i: Int): Double = coordinates[2 * i]
+    fun lng(i: Int): Double = coordinates[2 * i + 1]
+    fun isLost(i: Int): Boolean = flags[i].toInt() and LOST != 0
+    fun hasImage(i: Int): Boolean = flags[i].toInt() and HAS_IMAGE != 0
+    fun id(i: Int): String = string(STRINGS_PER_PIN * i)
+    fun label(i: Int): String = string(STRINGS_PER_PIN * i + 1)
+    fun imageUrl(i: Int): String = string(STRINGS_PER_PIN * i + 2)
+
+    private fun string(slot: Int) =
+        strings.decodeToString(stringOffsets[slot], stringOffsets[slot + 1])
+
+    /** Appends pins into growable columns; [build] trims them to size. */
+    class Builder(capacity: Int = 16) {
+        private var size = 0
+        private var coordinates = DoubleArray(2 * capacity)
+        private var flags = ByteArray(capacity)
+        private var strings = ByteArray(capacity * 32)
+        private var stringsSize = 0
+        private var stringOffsets = IntArray(STRINGS_PER_PIN * capacity + 1)
+
+        fun add(id: String, lat: Double, lng: Double, isLost: Boolean, label: String, imageUrl: String) {
+            if (size == flags.size) {
+                val capacity = maxOf(16, size * 2)
+                coordinates = coordinates.copyOf(2 * capacity)
+                flags = flags.copyOf(capacity)
+                stringOffsets = stringOffsets.copyOf(STRINGS_PER_PIN * capacity + 1)
+            }
+            coordinates[2 * size] = lat
+            coordinates[2 * size + 1] = lng
+            flags[size] = ((if (isLost) LOST else 0) or (if (imageUrl.isNotEmpty()) HAS_IMAGE else 0)).toByte()
+            appendString(STRINGS_PER_PIN * size, id)
+            appendString(STRINGS_PER_PIN * size + 1, label)
+            appendString(STRINGS_PER_PIN * size + 2, imageUrl)
+            size++
+        }
+
+        private fun appendString(slot: Int, value: String) {
+            val bytes = value.encodeToByteArray()
+            if (stringsSize + bytes.size > strings.size) {
+                strings = strings.copyOf(maxOf(strings.size * 2, stringsSize + bytes.size))
+            }
+            bytes.copyInto(strings, stringsSize)
+            stringsSize += bytes.size
+            stringOffsets[slot + 1] = stringsSize
+        }
+
+        fun build() = MapPinBatch(
+            size = size,
+            coordinates = coordinates.copyOf(2 * size),
+            flags = flags.copyOf(size),
+            strings = strings.copyOf(stringsSize),
+            stringOffsets = stringOffsets.copyOf(STRINGS_PER_PIN * size + 1)
+        )
+    }
+
+    companion object {
+        const val LOST = 1
+        const val HAS_IMAGE = 2
+        const val STRINGS_PER_PIN = 3
+
+        val EMPTY = Builder(0).build()
+    }
+}
+
+/** Pins for the reports that have coordinates, in list order. */
+fun List<ReportModel>.toMapPinBatch(): MapPinBatch {
+    val builder = MapPinBatch.Builder(size)
+    for (report in this) {
+        if (report.lat.isNaN() || report.lng.isNaN()) continue
+        builder.add(report.id, report.lat, report.lng, report.isLost, report.name, report.imageUrl)
+    }
+    return builder.build()
+}
@@ -0,0 +1,4 @@
+package org.example.project.data.report
+
+/** A report and its great-circle distance from the point it was searched around. */
+data class NearbyReport(val report: ReportModel, val distanceMeters: Double)
@@ -0,0 +1,13 @@
+package org.example.project.data.report
+
+/** Position after the last row of a page, in `createdAt DESC, id DESC` order. */
+data class PageKey(
+    val createdAt: Long,
+    val id: String
+)
+
+/** One slice of a keyset-paged list; [next] is null on the last page. */
+data class Page<T>(
+    val items: List<T>,
+    val next: PageKey?
+)
@@ -0,0 +1,19 @@
+package org.example.project.data.report
+
+/** One remote document change, as delivered by a Firestore snapshot listener. */
+sealed class ReportChange {
+    abstract val id: String
+    abstract val updatedAt: Long
+
+    // Added or modified; the report's full current state.
+    data class Upserted(val report: ReportModel) : ReportChange() {
+        override val id: String get() = report.id
+        override val updatedAt: Long get() = report.updatedAt
+    }
+
+    // Tombstoned or hard-deleted. [updatedAt] is 0 when the document itself is gone.
+    data class Removed(
+        override val id: String,
+        override val updatedAt: Long = 0L
+    ) : ReportChange()
+}
@@ -0,0 +1,29 @@
+package org.example.project.data.report
+
+import org.example.project.geo.MarkerClusterIndex
+
+/** Map-marker cluster index over the reports that have coordinates. */
+fun reportClusterIndex(reports: List<ReportModel>): MarkerClusterIndex<ReportModel> =
+    MarkerClusterIndex(
+        items = reports.filter { !it.lat.isNaN() && !it.lng.isNaN() },
+        latOf = { it.lat },
+        lngOf = { it.lng }
+    )
+
+/**
+ * The pins loaded for a viewport and their cluster index. When [truncated], the
+ * pin query hit its cap and cluster counts are lower bounds.
+ */
+class MapPinClusters(
+    val pins: MapPinBatch,
+    val index: MarkerClusterIndex<Int>,
+    val truncated: Boolean
+)
+
+/** Map-marker cluster index over [pins]; each single marker's item is its index in [pins]. */
+fun mapPinClusterIndex(pins: MapPinBatch): MarkerClusterIndex<Int> =
+    MarkerClusterIndex(
+        items = List(pins.size) { it },
+        latOf = { pins.lat(it) },
+        lngOf = { pins.lng(it) }
+    )
@@ -0,0 +1,13 @@
+package org.example.project.data.report
+
+/**
+ * The report list a screen shows. It outlives individual operations: saving or
+ * deleting reports through [ReportUiState] never replaces it, and a failed
+ * reload keeps the previous reports next to the [error].
+ */
+data class ReportListState(
+    val reports: List<ReportModel> = emptyList(),
+    val isLoading: Boolean = false,
+    val hasMore: Boolean = false,      // paged lists only: further pages can be loaded
+    val error: Throwable? = null
+)
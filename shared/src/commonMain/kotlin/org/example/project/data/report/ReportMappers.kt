@@ -9,7 +9,7 @@ fun Reports.toModel() = ReportModel(
     imageUrl = imageUrl,
     isLost = isLost,
     location = location,
-    lat = lat,
-    lng = lng,
+    lat = lat ?: Double.NaN,
+    lng = lng ?: Double.NaN,
     createdAt = createdAt
 )
\ No newline at end of file
@@ -0,0 +1,27 @@
+package org.example.project.data.report
+
+import app.cash.sqldelight.db.AfterVersion
+import app.cash.sqldelight.db.SqlDriver
+import org.example.project.geo.Geohash
+
+/**
+ * Kotlin-side steps of schema migrations that SQL alone cannot express.
+ * Pass [callbacks] to every platform driver next to `AppDatabase.Schema`.
+ */
+object ReportMigrations {
+    val callbacks: Array<AfterVersion> = arrayOf(
+        // 2.sqm added reports.geohash
+        AfterVersion(2) { driver -> backfillGeohashes(driver) }
+    )
+
+    fun backfillGeohashes(driver: SqlDriver) {
+        val q = AppDatabase(driver).reportQueries
+        q.transaction {
+            q.selectMissingGeohash().executeAsList().forEach { row ->
+                val lat = row.lat ?: return@forEach
+                val lng = row.lng ?: return@forEach
+                q.updateGeohash(Geohash.encode(lat, lng), row.id)
+            }
+        }
+    }
+}
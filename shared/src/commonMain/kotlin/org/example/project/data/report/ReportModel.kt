@@ -14,5 +14,7 @@ data class ReportModel(
     val location: String? = null,
     val lat: Double = Double.NaN,
     val lng: Double = Double.NaN,
-    val createdAt: Long = 0L
+    val createdAt: Long = 0L,
+    val updatedAt: Long = 0L,   // epoch millis of the last remote write; drives delta sync
+    val deleted: Boolean = false // tombstone: the report was deleted remotely
 )
\ No newline at end of file
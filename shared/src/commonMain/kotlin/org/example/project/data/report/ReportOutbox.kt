@@ -0,0 +1,109 @@
+package org.example.project.data.report
+
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.SupervisorJob
+import kotlinx.coroutines.channels.Channel
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.withContext
+import kotlinx.coroutines.withTimeoutOrNull
+import kotlinx.datetime.Clock
+import org.example.project.data.firebase.FirebaseRepository
+import org.example.project.data.firebase.RemoteFirebaseRepository
+import kotlin.random.Random
+
+/** An outbox entry taken by one flush; [version] identifies the state that was sent. */
+data class OutboxClaim(val write: ReportWrite, val version: Long, val attempts: Long)
+
+/**
+ * Write-behind for report mutations.
+ *
+ * [ReportRepositoryImpl] applies a mutation to SQLite and appends it to the
+ * `outbox` table in the same transaction, so screens see it at once and it
+ * survives a restart. This class drains the table in the background: due
+ * entries go to Firestore in batches of up to [BATCH_SIZE], one atomic round
+ * trip each, and a failed batch is retried with exponential backoff. An entry
+ * edited while its batch is in flight keeps its row and goes out again with
+ * the folded state.
+ *
+ * One outbox drains the table for the whole process: [shared], started by
+ * [DatabaseModule.init]. Claims are leased (see [LocalReportDataSource.claimOutbox]),
+ * so an extra instance, e.g. in a test, never sends an entry that is in flight.
+ */
+class ReportOutbox(
+    private val firebase: FirebaseRepository,
+    private val local: LocalReportDataSource,
+    private val io: CoroutineDispatcher = Dispatchers.Default,
+    private val clock: () -> Long = { Clock.System.now().toEpochMilliseconds() }
+) {
+    private val wakeups = Channel<Unit>(Channel.CONFLATED)
+    private var job: Job? = null
+
+    /** Starts the drain loop in [scope]; later calls do nothing. */
+    fun start(scope: CoroutineScope = CoroutineScope(Dispatchers.Default + SupervisorJob())) {
+        if (job != null) return
+        // the first pass also drains whatever a previous run left behind
+        job = scope.launch { run() }
+    }
+
+    /** Asks for a flush; call after every enqueue. */
+    fun kick() {
+        wakeups.trySend(Unit)
+    }
+
+    private suspend fun run() {
+        while (true) {
+            val nextDue = try {
+                flush()
+            } catch (e: CancellationException) {
+                throw e
+            } catch (e: Throwable) {
+                clock() + MIN_BACKOFF_MS   // SQLite trouble: try again later
+            }
+            when {
+                nextDue == null -> wakeups.receive()
+                nextDue > clock() -> withTimeoutOrNull(nextDue - clock()) { wakeups.receive() }
+            }
+        }
+    }
+
+    /**
+     * Sends every entry that is due. Returns when the next remaining entry falls
+     * due, or null once the outbox is empty.
+     */
+    suspend fun flush(): Long? {
+        while (true) {
+            val now = clock()
+            val batch = withContext(io) { local.claimOutbox(now, BATCH_SIZE) }
+            if (batch.isEmpty()) break
+            try {
+                firebase.writeReports(batch.map { it.write })
+            } catch (e: CancellationException) {
+                throw e
+            } catch (e: Throwable) {
+                withContext(io) { local.retryOutbox(batch, e.message) { now + backoffMs(it.attempts) } }
+                break
+            }
+            withContext(io) { local.acknowledgeOutbox(batch) }
+        }
+        return withContext(io) { local.nextOutboxAttemptAt() }
+    }
+
+    // Jitter keeps devices that went offline together from retrying in lockstep.
+    private fun backoffMs(attempts: Long): Long {
+        val doublings = (attempts - 1).coerceIn(0, 16).toInt()
+        val base = (MIN_BACKOFF_MS shl doublings).coerceAtMost(MAX_BACKOFF_MS)
+        return base + Random.nextLong(base / 5 + 1)
+    }
+
+    companion object {
+        const val BATCH_SIZE = 100                   // Firestore allows 500 writes per batch
+        const val MIN_BACKOFF_MS = 2_000L
+        const val MAX_BACKOFF_MS = 5 * 60 * 1000L
+
+        val shared: ReportOutbox by lazy { ReportOutbox(RemoteFirebaseRepository(), LocalReportDataSource()) }
+    }
+}
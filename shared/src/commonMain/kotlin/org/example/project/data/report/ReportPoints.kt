@@ -0,0 +1,11 @@
+package org.example.project.data.report
+
+import org.example.project.geo.GeoPoints
+
+/** Coordinates for [org.example.project.geo.DistanceKernel]; point `i` is report `i`. */
+fun List<ReportModel>.toGeoPoints(): GeoPoints =
+    GeoPoints(DoubleArray(size) { this[it].lat }, DoubleArray(size) { this[it].lng })
+
+/** Coordinates for [org.example.project.geo.DistanceKernel]; point `i` is pin `i`. */
+fun MapPinBatch.toGeoPoints(): GeoPoints =
+    GeoPoints(DoubleArray(size) { lat(it) }, DoubleArray(size) { lng(it) })
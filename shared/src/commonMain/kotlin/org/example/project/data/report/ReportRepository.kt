@@ -1,7 +1,12 @@
 package org.example.project.data.report
 
+import kotlinx.coroutines.flow.Flow
+import org.example.project.geo.GeoBounds
+import org.example.project.location.Location
 
 interface ReportRepository {
+    // Writes land in the local cache at once, so observers see them without a refetch,
+    // and reach the remote in the background through the outbox (see ReportOutbox).
     suspend fun saveReport(
         description: String,
         name: String,
@@ -11,11 +16,57 @@ interface ReportRepository {
         location: String? = null,
         lat: Double,
         lng: Double
-    )
+    ): ReportModel
 
     suspend fun getReportsForUser(userId: String): List<ReportModel>
     suspend fun getAllReports(): List<ReportModel>
 
+    // Emit the locally cached reports first, then again whenever a refresh lands.
+    fun observeAllReports(): Flow<List<ReportModel>>
+    fun observeReportsForUser(userId: String): Flow<List<ReportModel>>
+
+    // Local, index-backed viewport queries; they only hit the remote while the cache is cold.
+    // At most [limit] reports are returned, newest first.
+    suspend fun getReportsInBounds(bounds: GeoBounds, limit: Int = Int.MAX_VALUE): List<ReportModel>
+    fun observeReportsInBounds(bounds: GeoBounds, limit: Int = Int.MAX_VALUE): Flow<List<ReportModel>>
+    // The same reports as pins only, in columns: what iOS draws without a ReportModel per pin.
+    suspend fun getMapPinsInBounds(bounds: GeoBounds, limit: Int = Int.MAX_VALUE): MapPinBatch
+    fun observeMapPinsInBounds(bounds: GeoBounds, limit: Int = Int.MAX_VALUE): Flow<MapPinBatch>
+
+    // One cached report, e.g. the one behind a tapped pin; null when it is not cached.
+    suspend fun getReport(id: String): ReportModel?
+
+    // Keyset-paged local reads, newest first; each page is read when the collector asks for it.
+    fun reportPagesForUser(
+        userId: String,
+        pageSize: Int = LocalReportDataSource.DEFAULT_PAGE_SIZE
+    ): Flow<Page<ReportModel>>
+
+    // Emits once the cache is usable and again whenever the user's cached reports
+    // change; paged readers restart their cursor on each emission.
+    fun observeReportsChangedForUser(userId: String): Flow<Unit>
+
+    // Up to [k] cached reports within [maxRadiusMeters] of [location], nearest first by
+    // great-circle distance; an expanding R*Tree search, not a scan.
+    suspend fun nearest(
+        location: Location,
+        k: Int = LocalReportDataSource.DEFAULT_NEAREST_K,
+        maxRadiusMeters: Double = LocalReportDataSource.DEFAULT_NEAREST_RADIUS_M
+    ): List<NearbyReport>
+
+    // Ranked, prefix-matching full-text search over the local cache.
+    suspend fun search(
+        query: String,
+        limit: Int = LocalReportDataSource.DEFAULT_SEARCH_LIMIT
+    ): List<ReportModel>
+
+    // Pulls remote changes into the local cache.
+    suspend fun refreshReports()
+
+    // Streams remote changes into the local cache until cancelled; observers of the
+    // local flows (observeAllReports, ...) update as events land.
+    suspend fun streamReportChanges()
+
 
     suspend fun updateReport(
         reportId: String,
@@ -27,7 +78,7 @@ interface ReportRepository {
         location: String? = null,
         lat: Double? =null,
         lng: Double?=null
-    )
+    ): ReportModel?   // the updated report, or null when it was not cached locally
 
     suspend fun deleteReport(reportId: String)
 }
\ No newline at end of file
@@ -1,13 +1,48 @@
 package org.example.project.data.report
 
 
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.SupervisorJob
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.emitAll
+import kotlinx.coroutines.flow.first
+import kotlinx.coroutines.flow.flow
+import kotlinx.coroutines.flow.map
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.withContext
+import kotlinx.datetime.Clock
 import org.example.project.data.firebase.FirebaseRepository
 import org.example.project.data.firebase.RemoteFirebaseRepository
+import org.example.project.geo.GeoBounds
+import org.example.project.location.Location
+import kotlin.random.Random
 
+/**
+ * Stale-while-revalidate: reads are served from SQLite, the remote is only
+ * awaited when the cache is still empty, otherwise it refreshes in [scope]
+ * and the result reaches observers through [LocalReportDataSource.observeAll].
+ * Refreshes are delta syncs (see [ReportSyncEngine]).
+ *
+ * Writes are local-first: they land in SQLite together with an outbox entry and
+ * return at once; [outbox] sends them to Firestore in the background. It is the
+ * process-wide [ReportOutbox.shared] by default, so repositories are cheap to create.
+ *
+ * Remote syncs and one-shot list reads go through [requests], which is shared
+ * process-wide by default, so concurrent callers coalesce onto one fetch.
+ */
 class ReportRepositoryImpl(
-    private val firebase: FirebaseRepository
+    private val firebase: FirebaseRepository,
+    private val local: LocalReportDataSource,
+    private val scope: CoroutineScope = CoroutineScope(Dispatchers.Default + SupervisorJob()),
+    private val io: CoroutineDispatcher = Dispatchers.Default,
+    private val requests: ReportRequests = ReportRequests.shared,
+    private val outbox: ReportOutbox = ReportOutbox.shared
 ) : ReportRepository {
-    constructor() : this(RemoteFirebaseRepository())
+    private val syncEngine = ReportSyncEngine(firebase, local, io)
+
+    constructor() : this(RemoteFirebaseRepository(), LocalReportDataSource())
     override suspend fun saveReport(
         description: String,
         name: String,
@@ -17,16 +52,103 @@ class ReportRepositoryImpl(
         location: String?,
         lat: Double,
         lng: Double
-    ) {
-        firebase.saveReport(description, name, phone, imageUrl, isLost, location, lat, lng)
+    ): ReportModel {
+        val userId = firebase.currentUserUid()
+            ?: throw IllegalStateException("No authenticated user!")
+        val now = nowMillis()
+        val report = ReportModel(
+            id = newReportId(),
+            userId = userId,
+            description = description,
+            name = name,
+            phone = phone,
+            imageUrl = imageUrl,
+            isLost = isLost,
+            location = location,
+            lat = lat,
+            lng = lng,
+            createdAt = now,
+            updatedAt = now
+        )
+        withContext(io) { local.saveLocally(report, now) }
+        requests.lists.invalidate()
+        outbox.kick()
+        return report
     }
 
     override suspend fun getReportsForUser(userId: String): List<ReportModel> =
-        firebase.getReportsForUser(userId)
+        requests.lists.get("user:$userId", ReportRequests.LIST_TTL_MS) {
+            observeReportsForUser(userId).first()
+        }
 
     override suspend fun getAllReports(): List<ReportModel> =
-        firebase.getAllReports()
+        requests.lists.get("all", ReportRequests.LIST_TTL_MS) {
+            observeAllReports().first()
+        }
+
+    override fun observeAllReports(): Flow<List<ReportModel>> =
+        cacheThenRefresh(
+            cachedCount = { local.countAll() },
+            cached = { local.observeAll().map { rows -> rows.map { it.toModel() } } },
+            refresh = { sync(ReportRequests.REVALIDATE_AFTER_MS) }
+        )
+
+    override fun observeReportsForUser(userId: String): Flow<List<ReportModel>> =
+        cacheThenRefresh(
+            cachedCount = { local.countByUser(userId) },
+            cached = { local.observeByUser(userId).map { rows -> rows.map { it.toModel() } } },
+            refresh = { sync(ReportRequests.REVALIDATE_AFTER_MS) }
+        )
+
+    override fun reportPagesForUser(userId: String, pageSize: Int): Flow<Page<ReportModel>> =
+        local.pages(userId, pageSize)
+
+    override fun observeReportsChangedForUser(userId: String): Flow<Unit> =
+        cacheThenRefresh(
+            cachedCount = { local.countByUser(userId) },
+            cached = { local.observeChangesByUser(userId) },
+            refresh = { sync(ReportRequests.REVALIDATE_AFTER_MS) }
+        )
+
+    override suspend fun getReportsInBounds(bounds: GeoBounds, limit: Int): List<ReportModel> =
+        observeReportsInBounds(bounds, limit).first()
+
+    // No revalidation per viewport: camera moves are far more frequent than remote changes.
+    override fun observeReportsInBounds(bounds: GeoBounds, limit: Int): Flow<List<ReportModel>> = flow {
+        if (withContext(io) { local.countAll() } == 0L) sync(ReportRequests.REVALIDATE_AFTER_MS)
+        emitAll(local.observeInBounds(bounds, limit.toLong()).map { rows -> rows.map { it.toModel() } })
+    }
+
+    override suspend fun getMapPinsInBounds(bounds: GeoBounds, limit: Int): MapPinBatch {
+        if (withContext(io) { local.countAll() } == 0L) sync(ReportRequests.REVALIDATE_AFTER_MS)
+        return withContext(io) { local.getPinsInBounds(bounds, limit.toLong()) }
+    }
+
+    override fun observeMapPinsInBounds(bounds: GeoBounds, limit: Int): Flow<MapPinBatch> = flow {
+        if (withContext(io) { local.countAll() } == 0L) sync(ReportRequests.REVALIDATE_AFTER_MS)
+        emitAll(local.observePinsInBounds(bounds, limit.toLong()))
+    }
+
+    override suspend fun getReport(id: String): ReportModel? = withContext(io) { local.getById(id) }
+
+    override suspend fun nearest(location: Location, k: Int, maxRadiusMeters: Double): List<NearbyReport> {
+        if (withContext(io) { local.countAll() } == 0L) sync(ReportRequests.REVALIDATE_AFTER_MS)
+        return withContext(io) { local.getNearest(location.latitude, location.longitude, k, maxRadiusMeters) }
+    }
 
+    override suspend fun search(query: String, limit: Int): List<ReportModel> {
+        if (withContext(io) { local.countAll() } == 0L) sync(ReportRequests.REVALIDATE_AFTER_MS)
+        return withContext(io) { local.search(query, limit) }
+    }
+
+    // An explicit refresh never reuses an earlier result, only a run still in flight.
+    override suspend fun refreshReports() {
+        sync(maxAgeMs = 0L)
+    }
+
+    override suspend fun streamReportChanges() {
+        syncEngine.streamChanges()
+    }
 
     override suspend fun updateReport(
         reportId: String,
@@ -38,9 +160,55 @@ class ReportRepositoryImpl(
         location: String?,
         lat: Double?,
         lng: Double?
-    ) = firebase.updateReport(reportId, description, name, phone, imageUrl, isLost, location, lat, lng)
+    ): ReportModel? {
+        val patch = ReportPatch(description, name, phone, imageUrl, isLost, location, lat, lng)
+        if (patch == ReportPatch()) return withContext(io) { local.getById(reportId) }   // nothing to update
+        val updated = withContext(io) { local.updateLocally(reportId, patch, nowMillis()) }
+        requests.lists.invalidate()
+        outbox.kick()
+        return updated
+    }
 
-    override suspend fun deleteReport(reportId: String) =
-        firebase.deleteReport(reportId)
+    override suspend fun deleteReport(reportId: String) {
+        withContext(io) { local.deleteLocally(reportId, nowMillis()) }
+        requests.lists.invalidate()
+        outbox.kick()
+    }
 
+    private fun <T> cacheThenRefresh(
+        cachedCount: () -> Long,
+        cached: () -> Flow<T>,
+        refresh: suspend () -> Unit
+    ): Flow<T> = flow {
+        if (withContext(io) { cachedCount() } == 0L) {
+            // cold cache: nothing worth painting yet, so wait for (and surface errors from) the fetch
+            refresh()
+        } else {
+            refreshInBackground(refresh)
+        }
+        emitAll(cached())
+    }
+
+    private suspend fun sync(maxAgeMs: Long): Int =
+        requests.syncs.get(SYNC_KEY, maxAgeMs) {
+            syncEngine.sync().also { changed -> if (changed > 0) requests.lists.invalidate() }
+        }
+
+    private fun nowMillis(): Long = Clock.System.now().toEpochMilliseconds()
+
+    private fun refreshInBackground(refresh: suspend () -> Unit) {
+        // a failed revalidation keeps serving the stale rows
+        scope.launch { runCatching { refresh() } }
+    }
+
+    private companion object {
+        const val SYNC_KEY = "sync:" + ReportSyncEngine.COLLECTION
+        const val ID_ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+
+        // Same shape as Firestore's auto ids, chosen here so the outbox can write the
+        // document idempotently before the server has ever seen it.
+        fun newReportId(): String = buildString(20) {
+            repeat(20) { append(ID_ALPHABET[Random.nextInt(ID_ALPHABET.length)]) }
+        }
+    }
 }
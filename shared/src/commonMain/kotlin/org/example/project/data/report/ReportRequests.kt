@@ -0,0 +1,30 @@
+package org.example.project.data.report
+
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.SupervisorJob
+import org.example.project.SingleFlight
+
+/**
+ * Report fetches shared by every [ReportRepositoryImpl] in the process. Screens
+ * build their own repositories, but concurrent refreshes and reads of the same
+ * query still cost a single round trip.
+ */
+class ReportRequests(scope: CoroutineScope) {
+    // Delta syncs: concurrent callers share one run, and a background revalidation
+    // skips the remote entirely when a run finished less than REVALIDATE_AFTER_MS ago.
+    internal val syncs = SingleFlight<String, Int>(scope, retainMs = REVALIDATE_AFTER_MS)
+
+    // One-shot list reads, reused for LIST_TTL_MS; cleared by every write and by
+    // every sync that changed rows.
+    internal val lists = SingleFlight<String, List<ReportModel>>(scope, retainMs = LIST_TTL_MS)
+
+    companion object {
+        const val REVALIDATE_AFTER_MS = 10_000L
+        const val LIST_TTL_MS = 2_000L
+
+        val shared: ReportRequests by lazy {
+            ReportRequests(CoroutineScope(Dispatchers.Default + SupervisorJob()))
+        }
+    }
+}
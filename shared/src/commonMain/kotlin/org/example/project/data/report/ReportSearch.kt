@@ -0,0 +1,34 @@
+package org.example.project.data.report
+
+/**
+ * Turns free text typed by the user into an FTS5 MATCH expression for
+ * `reports_fts`. Every word becomes a quoted prefix term (`"word"*`), so FTS5
+ * operators and punctuation in the input are never interpreted, and the
+ * partially typed last word still matches.
+ */
+object ReportSearch {
+    private const val MAX_TERMS = 8
+
+    /** Null when the input has no searchable characters. */
+    fun toMatchQuery(input: String): String? {
+        val terms = tokenize(input).take(MAX_TERMS)
+        if (terms.isEmpty()) return null
+        return terms.joinToString(" ") { "\"$it\"*" }
+    }
+
+    // Same word boundaries as the unicode61 tokenizer: runs of letters and digits.
+    private fun tokenize(input: String): List<String> {
+        val terms = mutableListOf<String>()
+        val current = StringBuilder()
+        for (ch in input) {
+            if (ch.isLetterOrDigit()) {
+                current.append(ch)
+            } else if (current.isNotEmpty()) {
+                terms += current.toString()
+                current.clear()
+            }
+        }
+        if (current.isNotEmpty()) terms += current.toString()
+        return terms
+    }
+}
@@ -0,0 +1,89 @@
+package org.example.project.data.report
+
+import kotlinx.atomicfu.locks.SynchronizedObject
+import kotlinx.atomicfu.locks.synchronized
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.distinctUntilChanged
+import kotlinx.coroutines.flow.emitAll
+import kotlinx.coroutines.flow.flow
+import kotlinx.coroutines.flow.onEach
+
+/**
+ * Process-wide reports by id, so navigation can pass just an id.
+ *
+ * Every list a [ReportViewModel] shows and every write it makes passes through
+ * here, which makes [get] an O(1) hit for anything recently on screen. The
+ * store keeps the [capacity] most recently used reports; [observe] serves an
+ * entry at once when it is still held and then follows the SQLite row, so an
+ * evicted report is only a cache miss, and a screen never keeps showing a copy
+ * that sync or another screen has since changed.
+ */
+class ReportStore(
+    private val capacity: Int = DEFAULT_CAPACITY,
+    private val local: () -> LocalReportDataSource
+) {
+    private val lock = SynchronizedObject()
+
+    // Insertion order doubles as recency: a hit is re-inserted at the end, the head is evicted.
+    private val reports = LinkedHashMap<String, ReportModel>()
+
+    fun get(id: String): ReportModel? = synchronized(lock) {
+        reports.remove(id)?.also { reports[id] = it }
+    }
+
+    fun observe(id: String): Flow<ReportModel?> = flow {
+        get(id)?.let { emit(it) }
+        emitAll(
+            local().observeById(id).onEach { row ->
+                if (row != null) put(row) else remove(id)
+            }
+        )
+    }.distinctUntilChanged()
+
+    fun put(report: ReportModel) {
+        synchronized(lock) {
+            insert(report)
+            trim()
+        }
+    }
+
+    /**
+     * Lists are shown from the top, so the head of [list] is what the user sees:
+     * only its first [capacity] entries are kept, inserted back to front so the
+     * first one ends up most recent.
+     */
+    fun putAll(list: List<ReportModel>) {
+        if (list.isEmpty()) return
+        val head = list.subList(0, minOf(list.size, capacity))
+        synchronized(lock) {
+            for (i in head.indices.reversed()) insert(head[i])
+            trim()
+        }
+    }
+
+    fun remove(id: String) {
+        synchronized(lock) { reports.remove(id) }
+    }
+
+    private fun insert(report: ReportModel) {
+        reports.remove(report.id)
+        reports[report.id] = report
+    }
+
+    private fun trim() {
+        val overflow = reports.size - capacity
+        if (overflow <= 0) return
+        val oldest = reports.keys.iterator()
+        repeat(overflow) {
+            oldest.next()
+            oldest.remove()
+        }
+    }
+
+    companion object {
+        // Several screens of lists; a few MB of reports at most.
+        const val DEFAULT_CAPACITY = 2_000
+
+        val shared: ReportStore by lazy { ReportStore { LocalReportDataSource() } }
+    }
+}
@@ -0,0 +1,122 @@
+package org.example.project.data.report
+
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.ExperimentalCoroutinesApi
+import kotlinx.coroutines.channels.Channel
+import kotlinx.coroutines.channels.produce
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.withContext
+import kotlinx.datetime.Clock
+import org.example.project.data.firebase.FirebaseRepository
+
+/**
+ * Incremental pull of the `reports` collection into SQLite.
+ *
+ * The first run downloads a full snapshot; afterwards only documents whose
+ * `updatedAt` is newer than the stored high-water mark are fetched, and
+ * tombstones (`deleted = true`) remove the local row. Each batch is merged in a
+ * single transaction together with the new mark.
+ *
+ * `updatedAt` is stamped by each writing client's clock, so the mark is never
+ * stored more than [CLOCK_SKEW_MS] past this device's [clock]: one document from
+ * a device whose clock runs fast must not push the mark beyond the honest writes
+ * of every other device. Such a document is simply re-read until time catches up.
+ */
+class ReportSyncEngine(
+    private val firebase: FirebaseRepository,
+    private val local: LocalReportDataSource,
+    private val io: CoroutineDispatcher = Dispatchers.Default,
+    private val clock: () -> Long = { Clock.System.now().toEpochMilliseconds() }
+) {
+    /**
+     * How [streamChanges] has fared: listener changes received, and the SQLite
+     * transactions they were merged into. Far fewer [streamedBatches] than
+     * [streamedChanges] means bursts are being folded.
+     */
+    var streamedChanges = 0L
+        private set
+    var streamedBatches = 0L
+        private set
+
+    /** Returns the number of changed documents that were applied. */
+    suspend fun sync(): Int {
+        val mark = withContext(io) { local.highWaterMark(COLLECTION) }?.let(::clampMark)
+
+        if (mark == null) {
+            val snapshot = firebase.getAllReports()
+            withContext(io) {
+                local.mergeChanges(
+                    collection = COLLECTION,
+                    changes = snapshot,
+                    highWaterMark = clampMark(snapshot.maxOfOrNull { it.updatedAt } ?: 0L),
+                    fullSnapshot = true
+                )
+            }
+            return snapshot.size
+        }
+
+        // `updatedAt` is stamped by the writing client, so re-read a window behind the
+        // mark to tolerate clock skew between devices; re-applying a change is harmless.
+        val changes = firebase.getReportChangesSince(mark - CLOCK_SKEW_MS)
+        if (changes.isEmpty()) return 0
+
+        withContext(io) {
+            local.mergeChanges(
+                collection = COLLECTION,
+                changes = changes,
+                highWaterMark = maxOf(mark, clampMark(changes.maxOf { it.updatedAt }))
+            )
+        }
+        return changes.size
+    }
+
+    /**
+     * Keeps SQLite live: catches up with [sync], then applies snapshot-listener
+     * events as they arrive. When events come in faster than SQLite absorbs them,
+     * every batch that queued up meanwhile is merged (last change per id wins) and
+     * written in a single transaction. Returns only when the remote stream ends;
+     * cancel the caller to stop.
+     */
+    @OptIn(ExperimentalCoroutinesApi::class)
+    suspend fun streamChanges() = coroutineScope {
+        sync()
+        val mark = withContext(io) { local.highWaterMark(COLLECTION) }?.let(::clampMark) ?: 0L
+        val batches = produce(capacity = Channel.UNLIMITED) {
+            firebase.observeReportChanges(mark - CLOCK_SKEW_MS).collect { send(it) }
+        }
+        for (first in batches) {
+            val merged = LinkedHashMap<String, ReportChange>()
+            first.forEach { merged[it.id] = it }
+            var received = first.size
+            while (true) {
+                val next = batches.tryReceive().getOrNull() ?: break
+                next.forEach { merged[it.id] = it }
+                received += next.size
+            }
+            apply(merged.values.toList())
+            streamedChanges += received
+            streamedBatches++
+        }
+    }
+
+    private suspend fun apply(changes: List<ReportChange>) = withContext(io) {
+        val mark = local.highWaterMark(COLLECTION)?.let(::clampMark) ?: 0L
+        local.applyChanges(
+            collection = COLLECTION,
+            changes = changes,
+            highWaterMark = maxOf(mark, clampMark(changes.maxOf { it.updatedAt }))
+        )
+    }
+
+    // A mark a skewed clock pushed into the future is pulled back as well.
+    private fun clampMark(updatedAt: Long): Long = minOf(updatedAt, clock() + CLOCK_SKEW_MS)
+
+    /** Forgets the watermark so the next [sync] pulls a full snapshot again. */
+    suspend fun reset() = withContext(io) { local.resetSync(COLLECTION) }
+
+    companion object {
+        const val COLLECTION = "reports"
+        const val CLOCK_SKEW_MS = 5 * 60 * 1000L
+    }
+}
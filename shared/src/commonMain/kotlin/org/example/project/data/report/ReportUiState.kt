@@ -1,5 +1,6 @@
 package org.example.project.data.report
 
+// Status of the last save / update / delete; the list itself lives in ReportListState.
 sealed class ReportUiState {
     // --- saving a report ---
     object Idle           : ReportUiState()
@@ -7,11 +8,6 @@ sealed class ReportUiState {
     object SaveSuccess    : ReportUiState()
     data class SaveError(val throwable: Throwable) : ReportUiState()
 
-    // --- loading the list of reports ---
-    object LoadingReports : ReportUiState()
-    data class ReportsLoaded(val reports: List<ReportModel>) : ReportUiState()
-    data class LoadError(val throwable: Throwable) : ReportUiState()
-
     // --- updating or deleting a report ---
     object UpdateSuccess : ReportUiState()
     object DeleteSuccess : ReportUiState()
@@ -1,18 +1,49 @@
 package org.example.project.data.report
 
+import kotlinx.coroutines.CancellationException
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.Job
 import kotlinx.coroutines.SupervisorJob
+import kotlinx.coroutines.channels.Channel
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.isActive
 import kotlinx.coroutines.flow.*
 import kotlinx.coroutines.launch
+import org.example.project.Closeable
+import org.example.project.ObserveOptions
+import org.example.project.Observation
+import org.example.project.observeLatest
+import org.example.project.geo.GeoBounds
+import org.example.project.location.Location
+import kotlin.concurrent.Volatile
 
 class ReportViewModel(
     private val repo: ReportRepository = ReportRepositoryImpl(),
-    private val scope: CoroutineScope = CoroutineScope(Dispatchers.Default + SupervisorJob())
+    private val scope: CoroutineScope = CoroutineScope(Dispatchers.Default + SupervisorJob()),
+    private val store: ReportStore = ReportStore.shared
 ) {
+    // Two independent streams: the list a screen shows, and the status of the last
+    // save/update/delete. Mutations patch the list in place instead of replacing it.
+    // Everything shown or written also lands in [store], which id-based routes read.
+    private val _listState = MutableStateFlow(ReportListState())
+    val listState: StateFlow<ReportListState> = _listState.asStateFlow()
+
     private val _uiState = MutableStateFlow<ReportUiState>(ReportUiState.Idle)
     val uiState: StateFlow<ReportUiState> = _uiState.asStateFlow()
 
+    // The map's pins and clusters for the last viewport; null until one has loaded.
+    private val _mapPins = MutableStateFlow<MapPinClusters?>(null)
+    val mapPins: StateFlow<MapPinClusters?> = _mapPins.asStateFlow()
+
+    private var listJob: Job? = null
+    @Volatile private var listSource: ListSource = ListSource.None
+    private val loadMoreRequests = Channel<Unit>(Channel.CONFLATED)
+    private var pagedCount = 0
+    private val viewportLoader = ViewportReportLoader(repo)
+    private var viewportJob: Job? = null
+
     @Suppress("unused")
     constructor() : this(
         ReportRepositoryImpl(),
@@ -32,7 +63,12 @@ class ReportViewModel(
         scope.launch {
             _uiState.value = ReportUiState.Saving
             try {
-                repo.saveReport(description, name, phone, imageUrl, isLost, location, lat, lng)
+                val saved = repo.saveReport(description, name, phone, imageUrl, isLost, location, lat, lng)
+                store.put(saved)
+                // A ranked list (nearest) keeps its order; only a feed the report belongs to gets it on top.
+                if (listSource.takesNewReport(saved)) {
+                    patchList { reports -> listOf(saved) + reports.filterNot { it.id == saved.id } }
+                }
                 _uiState.value = ReportUiState.SaveSuccess
             } catch (e: Throwable) {
                 _uiState.value = ReportUiState.SaveError(e)
@@ -40,29 +76,151 @@ class ReportViewModel(
         }
     }
 
-    fun loadReportsForUser(userId: String) {
-        scope.launch {
-            _uiState.value = ReportUiState.LoadingReports
+    fun loadReportsForUser(userId: String) =
+        observeList(ListSource.User(userId)) { repo.observeReportsForUser(userId) }
+
+    /**
+     * "My reports" read page by page: the first page loads now, later ones on
+     * [loadMoreReports]. A change to the user's rows restarts the cursor and
+     * re-reads as many rows as were already on screen.
+     */
+    fun loadReportPagesForUser(userId: String) {
+        listJob?.cancel()
+        listSource = ListSource.User(userId)
+        pagedCount = 0
+        listJob = scope.launch {
+            _listState.update { it.copy(isLoading = true, error = null) }
             try {
-                val list = repo.getReportsForUser(userId)
-                _uiState.value = ReportUiState.ReportsLoaded(list)
+                repo.observeReportsChangedForUser(userId).collectLatest { readPages(userId) }
+            } catch (e: CancellationException) {
+                throw e
             } catch (e: Throwable) {
-                _uiState.value = ReportUiState.LoadError(e)
+                _listState.update { it.copy(isLoading = false, error = e) }
             }
         }
     }
 
-    fun loadAllReports() {
-        scope.launch {
-            _uiState.value = ReportUiState.LoadingReports
-            try {
-                val list = repo.getAllReports()
-                _uiState.value = ReportUiState.ReportsLoaded(list)
-            } catch (e: Throwable) {
-                _uiState.value = ReportUiState.LoadError(e)
+    fun loadMoreReports() {
+        loadMoreRequests.trySend(Unit)
+    }
+
+    private suspend fun readPages(userId: String) = coroutineScope {
+        // rendezvous: at most one page is read ahead of what is shown
+        val cursor = repo.reportPagesForUser(userId).buffer(Channel.RENDEZVOUS).produceIn(this)
+        val shown = mutableListOf<ReportModel>()
+        var hasMore = true
+
+        suspend fun pull() {
+            val page = cursor.receiveCatching().getOrNull()
+            if (page == null) {
+                hasMore = false
+                return
+            }
+            shown += page.items
+            store.putAll(page.items)
+            hasMore = page.next != null
+        }
+
+        fun publish() {
+            pagedCount = shown.size
+            _listState.value = ReportListState(reports = shown.toList(), hasMore = hasMore)
+        }
+
+        val restore = pagedCount
+        do pull() while (hasMore && shown.size < restore)
+        publish()
+
+        while (true) {
+            loadMoreRequests.receive()
+            if (!hasMore) continue
+            pull()
+            publish()
+        }
+    }
+
+    fun loadAllReports() =
+        observeList(ListSource.All) { repo.observeAllReports() }
+
+    // Reports closest to [location] (e.g. from LocationApi.get()), nearest first.
+    fun loadReportsNear(location: Location) =
+        observeList(ListSource.Nearest) { flow { emit(repo.nearest(location).map { it.report }) } }
+
+    /**
+     * Camera moved (call it for every frame, not only when the camera settles).
+     * Loads are debounced, cancelled when superseded and bounded in size; see
+     * [ViewportReportLoader]. Results land in [mapPins]; the previous viewport's
+     * pins stay there until the new ones arrive.
+     */
+    fun onViewportChanged(bounds: GeoBounds, zoom: Double) {
+        viewportLoader.update(bounds, zoom)
+        if (viewportJob?.isActive != true) {
+            viewportJob = scope.launch {
+                viewportLoader.pins()
+                    .catch { e -> _listState.update { it.copy(error = e) } }
+                    .collect { _mapPins.value = it }
             }
         }
     }
+
+    // Swift-facing [mapPins]: the newest pins on the main thread, at most once per UI tick.
+    fun observeMapPins(onChange: (MapPinClusters) -> Unit): Observation =
+        mapPins.filterNotNull().observeLatest(ObserveOptions.UI, onChange)
+
+    // Fire-and-forget sync; list observers pick up the result from the local cache.
+    fun refreshReports() {
+        scope.launch { runCatching { repo.refreshReports() } }
+    }
+
+    /**
+     * Streams remote changes into the local cache until the returned handle is
+     * closed; lists observed through this view model update as events land.
+     * A dropped listener reconnects with exponential backoff.
+     */
+    fun followRemoteChanges(): Closeable {
+        val job = scope.launch {
+            var backoffMs = FOLLOW_MIN_BACKOFF_MS
+            while (isActive) {
+                try {
+                    repo.streamReportChanges()
+                    backoffMs = FOLLOW_MIN_BACKOFF_MS
+                } catch (e: CancellationException) {
+                    throw e
+                } catch (e: Throwable) {
+                    backoffMs = (backoffMs * 2).coerceAtMost(FOLLOW_MAX_BACKOFF_MS)
+                }
+                delay(backoffMs)
+            }
+        }
+        return object : Closeable {
+            override fun close() = job.cancel()
+        }
+    }
+
+    // Cached rows arrive first; a background refresh re-emits through the same flow.
+    // The current reports stay in place until the new ones arrive.
+    private fun observeList(
+        kind: ListSource,
+        showLoading: Boolean = true,
+        source: () -> Flow<List<ReportModel>>
+    ) {
+        listJob?.cancel()
+        listSource = kind
+        listJob = scope.launch {
+            if (showLoading) _listState.update { it.copy(isLoading = true, error = null) }
+            source()
+                .catch { e -> _listState.update { it.copy(isLoading = false, error = e) } }
+                .collect { list ->
+                    store.putAll(list)
+                    _listState.value = ReportListState(reports = list)
+                }
+        }
+    }
+
+    // Equal lists are not re-emitted, so an unchanged list never recomposes.
+    private fun patchList(transform: (List<ReportModel>) -> List<ReportModel>) {
+        _listState.update { it.copy(reports = transform(it.reports)) }
+    }
+
     fun updateReport(
         reportId: String,
         description: String? = null,
@@ -77,7 +235,11 @@ class ReportViewModel(
         scope.launch {
             _uiState.value = ReportUiState.Saving
             try {
-                repo.updateReport(reportId, description, name, phone, imageUrl, isLost, location, lat, lng)
+                val updated = repo.updateReport(reportId, description, name, phone, imageUrl, isLost, location, lat, lng)
+                if (updated != null) {
+                    store.put(updated)
+                    patchList { reports -> reports.map { if (it.id == updated.id) updated else it } }
+                }
                 _uiState.value = ReportUiState.UpdateSuccess
             } catch (e: Throwable) {
                 _uiState.value = ReportUiState.UpdateError(e)
@@ -90,10 +252,31 @@ class ReportViewModel(
             _uiState.value = ReportUiState.Saving
             try {
                 repo.deleteReport(reportId)
+                store.remove(reportId)
+                patchList { reports -> reports.filterNot { it.id == reportId } }
                 _uiState.value = ReportUiState.DeleteSuccess
             } catch (e: Throwable) {
                 _uiState.value = ReportUiState.DeleteError(e)
             }
         }
     }
+
+    // What the current list shows, and so whether a newly saved report belongs on its top.
+    private sealed interface ListSource {
+        fun takesNewReport(report: ReportModel): Boolean = false
+
+        data object None : ListSource
+        data object Nearest : ListSource
+        data object All : ListSource {
+            override fun takesNewReport(report: ReportModel) = true
+        }
+        data class User(val userId: String) : ListSource {
+            override fun takesNewReport(report: ReportModel) = report.userId == userId
+        }
+    }
+
+    private companion object {
+        const val FOLLOW_MIN_BACKOFF_MS = 1_000L
+        const val FOLLOW_MAX_BACKOFF_MS = 60_000L
+    }
 }
\ No newline at end of file
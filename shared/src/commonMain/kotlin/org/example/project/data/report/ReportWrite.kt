@@ -0,0 +1,57 @@
+package org.example.project.data.report
+
+import kotlinx.serialization.Serializable
+
+/** The fields of a partial update; null fields are left as they are. */
+@Serializable
+data class ReportPatch(
+    val description: String? = null,
+    val name: String? = null,
+    val phone: String? = null,
+    val imageUrl: String? = null,
+    val isLost: Boolean? = null,
+    val location: String? = null,
+    val lat: Double? = null,
+    val lng: Double? = null
+) {
+    // A later edit wins field by field.
+    fun then(next: ReportPatch) = ReportPatch(
+        description = next.description ?: description,
+        name = next.name ?: name,
+        phone = next.phone ?: phone,
+        imageUrl = next.imageUrl ?: imageUrl,
+        isLost = next.isLost ?: isLost,
+        location = next.location ?: location,
+        lat = next.lat ?: lat,
+        lng = next.lng ?: lng
+    )
+
+    fun applyTo(report: ReportModel) = report.copy(
+        description = description ?: report.description,
+        name = name ?: report.name,
+        phone = phone ?: report.phone,
+        imageUrl = imageUrl ?: report.imageUrl,
+        isLost = isLost ?: report.isLost,
+        location = location ?: report.location,
+        lat = lat ?: report.lat,
+        lng = lng ?: report.lng
+    )
+}
+
+/**
+ * One outbox entry on its way to Firestore. Every write is idempotent, so a
+ * batch that is retried after a lost acknowledgement does no harm.
+ */
+sealed class ReportWrite {
+    abstract val id: String
+
+    // The report's full state, written under its client-generated id.
+    data class Create(val report: ReportModel) : ReportWrite() {
+        override val id: String get() = report.id
+    }
+
+    data class Update(override val id: String, val patch: ReportPatch) : ReportWrite()
+
+    // Written as a tombstone so delta sync can propagate it.
+    data class Delete(override val id: String) : ReportWrite()
+}
@@ -0,0 +1,101 @@
+package org.example.project.data.report
+
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.ExperimentalCoroutinesApi
+import kotlinx.coroutines.FlowPreview
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.MutableStateFlow
+import kotlinx.coroutines.flow.debounce
+import kotlinx.coroutines.flow.emitAll
+import kotlinx.coroutines.flow.filter
+import kotlinx.coroutines.flow.filterNotNull
+import kotlinx.coroutines.flow.flatMapLatest
+import kotlinx.coroutines.flow.flow
+import kotlinx.coroutines.flow.flowOn
+import kotlinx.coroutines.flow.map
+import kotlinx.coroutines.flow.onEach
+import org.example.project.geo.GeoBounds
+import kotlin.concurrent.Volatile
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.TimeSource
+
+/**
+ * Turns a stream of camera positions into the pins to draw and their clusters.
+ * Pins are a columnar [MapPinBatch] rather than reports, so the cap can be high
+ * enough that cluster counts cover the area; a capped result is marked
+ * [MapPinClusters.truncated].
+ *
+ * Each stage has a latency budget so a continuous pan stays smooth:
+ * - camera updates are debounced by [DEBOUNCE]; a pan costs one query once it pauses
+ * - a newer viewport cancels the load still running for the previous one
+ * - the query covers the viewport plus [MARGIN] of its size on every side, and a
+ *   viewport still inside the last fully loaded area needs no query at all
+ * - a query slower than [QUERY_BUDGET] halves the pin cap for the next ones, and
+ *   the cap grows back while queries stay well under budget
+ * - the cluster index is built on [Dispatchers.Default], never on the caller's thread
+ */
+class ViewportReportLoader(
+    private val repo: ReportRepository,
+    private val debounce: Duration = DEBOUNCE
+) {
+    data class Viewport(val bounds: GeoBounds, val zoom: Double)
+
+    private val viewports = MutableStateFlow<Viewport?>(null)
+
+    fun update(bounds: GeoBounds, zoom: Double) {
+        viewports.value = Viewport(bounds, zoom)
+    }
+
+    // Per collection of [pins]. Written once per load, below `flowOn`, and read by
+    // the viewport filter, which runs in a different coroutine: hence @Volatile.
+    private class LoadState {
+        @Volatile var loadedArea: GeoBounds? = null
+        @Volatile var pinCap = MAX_PINS
+    }
+
+    /** Each collection starts with nothing on screen and its own cap. */
+    @OptIn(FlowPreview::class, ExperimentalCoroutinesApi::class)
+    fun pins(): Flow<MapPinClusters> = flow {
+        val state = LoadState()
+        emitAll(viewports
+            .filterNotNull()
+            .debounce(debounce)
+            .filter { viewport -> state.loadedArea?.contains(viewport.bounds) != true }
+            .flatMapLatest { viewport ->
+                val area = viewport.bounds.expandedBy(MARGIN)
+                val cap = state.pinCap
+                val started = TimeSource.Monotonic.markNow()
+                var first = true
+                repo.observeMapPinsInBounds(area, cap)
+                    .map { pins ->
+                        val took = started.elapsedNow()   // the query alone, before the index
+                        MapPinClusters(pins, mapPinClusterIndex(pins), truncated = pins.size >= cap) to took
+                    }
+                    .flowOn(Dispatchers.Default)
+                    .onEach { (loaded, took) ->
+                        if (first) {
+                            first = false
+                            state.pinCap = nextPinCap(state.pinCap, took)
+                            // a truncated result does not cover the area, so never reuse it
+                            state.loadedArea = if (loaded.truncated) null else area
+                        }
+                    }
+                    .map { (loaded, _) -> loaded }
+            })
+    }
+
+    private fun nextPinCap(pinCap: Int, took: Duration): Int = when {
+        took > QUERY_BUDGET -> (pinCap / 2).coerceAtLeast(MIN_PINS)
+        took < QUERY_BUDGET / 4 -> (pinCap * 2).coerceAtMost(MAX_PINS)
+        else -> pinCap
+    }
+
+    companion object {
+        val DEBOUNCE = 150.milliseconds
+        val QUERY_BUDGET = 50.milliseconds
+        const val MARGIN = 0.5
+        const val MAX_PINS = 20_000
+        const val MIN_PINS = 2_500
+    }
+}
@@ -0,0 +1,162 @@
+package org.example.project.geo
+
+import kotlin.math.PI
+import kotlin.math.abs
+import kotlin.math.asin
+import kotlin.math.cos
+import kotlin.math.min
+import kotlin.math.sin
+import kotlin.math.sqrt
+
+/**
+ * Points stored column-wise for [DistanceKernel]: latitude and longitude in
+ * radians, and each point's unit vector on the sphere, all computed once so the
+ * kernel's loops are plain arithmetic over primitive arrays. A point with a NaN
+ * coordinate never matches a radius.
+ */
+class GeoPoints(latDegrees: DoubleArray, lngDegrees: DoubleArray) {
+    init {
+        require(latDegrees.size == lngDegrees.size) { "${latDegrees.size} latitudes for ${lngDegrees.size} longitudes" }
+    }
+
+    val size: Int = latDegrees.size
+
+    internal val lat = DoubleArray(size) { latDegrees[it] * RADIANS }
+    internal val lng = DoubleArray(size) { lngDegrees[it] * RADIANS }
+    internal val x = DoubleArray(size) { cos(lat[it]) * cos(lng[it]) }
+    internal val y = DoubleArray(size) { cos(lat[it]) * sin(lng[it]) }
+    internal val z = DoubleArray(size) { sin(lat[it]) }
+}
+
+/**
+ * Distances from one point to a whole [GeoPoints] batch.
+ *
+ * The hot loops are counted, branch-free and read only primitive arrays, which
+ * is the shape HotSpot's superword pass and LLVM's loop vectoriser turn into SIMD.
+ * Exact distances come from the chord between unit vectors: haversine's
+ * `sin²(Δφ/2) + cos φ₁ cos φ₂ sin²(Δλ/2)` equals a quarter of the squared chord,
+ * so the per-point work is three subtractions and a dot product, with the one
+ * `asin` left to the points that are kept. Unlike the `(1 - cos)/2` form, the
+ * chord keeps full precision down to centimetres.
+ */
+object DistanceKernel {
+
+    /** Squared chord from ([lat], [lng]) to every point, into [out]; grows with distance, so it ranks. */
+    fun chordSq(points: GeoPoints, lat: Double, lng: Double, out: DoubleArray) {
+        val n = points.size
+        require(out.size >= n)
+        val qLat = lat * RADIANS
+        val qLng = lng * RADIANS
+        val qx = cos(qLat) * cos(qLng)
+        val qy = cos(qLat) * sin(qLng)
+        val qz = sin(qLat)
+        val x = points.x
+        val y = points.y
+        val z = points.z
+        for (i in 0 until n) {
+            val dx = x[i] - qx
+            val dy = y[i] - qy
+            val dz = z[i] - qz
+            out[i] = dx * dx + dy * dy + dz * dz
+        }
+    }
+
+    /** Great-circle distance in meters from ([lat], [lng]) to every point, into [out]. */
+    fun haversine(points: GeoPoints, lat: Double, lng: Double, out: DoubleArray) {
+        chordSq(points, lat, lng, out)
+        for (i in 0 until points.size) out[i] = chordSqToMeters(out[i])
+    }
+
+    /**
+     * Equirectangular distance in meters, scaled at the query latitude, into [out].
+     * Within a few percent at city scale and cheaper than [haversine]; good for a
+     * rough ordering, not for deciding what is inside a radius.
+     */
+    fun equirectangular(points: GeoPoints, lat: Double, lng: Double, out: DoubleArray) {
+        val n = points.size
+        require(out.size >= n)
+        val qLat = lat * RADIANS
+        val qLng = lng * RADIANS
+        val scale = cos(qLat)
+        val pLat = points.lat
+        val pLng = points.lng
+        for (i in 0 until n) {
+            val dLat = pLat[i] - qLat
+            val d = abs(pLng[i] - qLng)
+            val dLng = min(d, TWO_PI - d) * scale   // the short way round
+            out[i] = EARTH_RADIUS_M * sqrt(dLat * dLat + dLng * dLng)
+        }
+    }
+
+    /**
+     * Points within [radiusMeters] of ([lat], [lng]), in index order: indices into
+     * [indices], distances in meters into [distances], both at least
+     * [GeoPoints.size] long. Returns how many were written.
+     *
+     * The first pass keeps points inside the circle's equirectangular bounding
+     * box ([boundsAround]), which reads only the two radian columns; the exact
+     * chord test then runs for those alone, so a small circle over a large batch
+     * never loads most points' unit vectors.
+     */
+    fun withinRadius(
+        points: GeoPoints,
+        lat: Double,
+        lng: Double,
+        radiusMeters: Double,
+        indices: IntArray,
+        distances: DoubleArray
+    ): Int {
+        val n = points.size
+        require(indices.size >= n && distances.size >= n)
+        val angle = radiusMeters / EARTH_RADIUS_M
+        val qLat = lat * RADIANS
+        val qLng = lng * RADIANS
+        val halfWidth = longitudeHalfWidth(qLat, angle)
+        val pLat = points.lat
+        val pLng = points.lng
+        // pass 1: box mask, parked in [distances] (1 inside, 0 outside)
+        for (i in 0 until n) {
+            val d = abs(pLng[i] - qLng)
+            val inBox = (abs(pLat[i] - qLat) <= angle) and (min(d, TWO_PI - d) <= halfWidth)   // no short circuit
+            distances[i] = if (inBox) 1.0 else 0.0
+        }
+
+        // pass 2: exact test and compaction; slot `count` never runs ahead of `i`,
+        // so the mask is read before its slot is reused
+        val half = sin(min(angle, PI) / 2)
+        val maxChordSq = 4 * half * half
+        val qx = cos(qLat) * cos(qLng)
+        val qy = cos(qLat) * sin(qLng)
+        val qz = sin(qLat)
+        val x = points.x
+        val y = points.y
+        val z = points.z
+        var count = 0
+        for (i in 0 until n) {
+            if (distances[i] == 0.0) continue
+            val dx = x[i] - qx
+            val dy = y[i] - qy
+            val dz = z[i] - qz
+            val c = dx * dx + dy * dy + dz * dz
+            if (c <= maxChordSq) {
+                indices[count] = i
+                distances[count] = chordSqToMeters(c)
+                count++
+            }
+        }
+        return count
+    }
+
+    /** Indices of up to [k] points within [maxRadiusMeters] of ([lat], [lng]), nearest first. */
+    fun nearest(points: GeoPoints, lat: Double, lng: Double, k: Int, maxRadiusMeters: Double): IntArray {
+        val indices = IntArray(points.size)
+        val distances = DoubleArray(points.size)
+        val found = withinRadius(points, lat, lng, maxRadiusMeters, indices, distances)
+        return (0 until found).sortedBy { distances[it] }.take(k).map { indices[it] }.toIntArray()
+    }
+
+    private fun chordSqToMeters(chordSq: Double): Double =
+        2 * EARTH_RADIUS_M * asin(min(1.0, sqrt(chordSq) / 2))
+
+    private const val TWO_PI = 2 * PI
+}
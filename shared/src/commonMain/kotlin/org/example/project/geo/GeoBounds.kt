@@ -0,0 +1,57 @@
+package org.example.project.geo
+
+/**
+ * Axis-aligned lat/lng rectangle in degrees. `west > east` means the box
+ * crosses the antimeridian.
+ */
+data class GeoBounds(
+    val south: Double,
+    val west: Double,
+    val north: Double,
+    val east: Double
+) {
+    val crossesAntimeridian: Boolean get() = west > east
+
+    fun contains(lat: Double, lng: Double): Boolean {
+        if (lat < south || lat > north) return false
+        return if (crossesAntimeridian) lng >= west || lng <= east else lng in west..east
+    }
+
+    /** True when [other] lies entirely inside this box. */
+    fun contains(other: GeoBounds): Boolean {
+        if (other.south < south || other.north > north) return false
+        if (west == -180.0 && east == 180.0) return true
+        return when {
+            crossesAntimeridian == other.crossesAntimeridian -> other.west >= west && other.east <= east
+            crossesAntimeridian -> other.west >= west || other.east <= east
+            else -> false
+        }
+    }
+
+    /** Grows every side by [fraction] of the box's span, clamped to valid coordinates. */
+    fun expandedBy(fraction: Double): GeoBounds {
+        val dLat = (north - south) * fraction
+        val lngSpan = if (crossesAntimeridian) east + 360.0 - west else east - west
+        val dLng = lngSpan * fraction
+        if (lngSpan + 2 * dLng >= 360.0) {
+            return GeoBounds((south - dLat).coerceAtLeast(-90.0), -180.0, (north + dLat).coerceAtMost(90.0), 180.0)
+        }
+        return GeoBounds(
+            south = (south - dLat).coerceAtLeast(-90.0),
+            west = wrapLng(west - dLng),
+            north = (north + dLat).coerceAtMost(90.0),
+            east = wrapLng(east + dLng)
+        )
+    }
+
+    /** One box, or two when the box crosses the antimeridian. */
+    fun splitAtAntimeridian(): List<GeoBounds> =
+        if (!crossesAntimeridian) listOf(this)
+        else listOf(copy(east = 180.0), copy(west = -180.0))
+
+    private fun wrapLng(lng: Double): Double = when {
+        lng > 180.0 -> lng - 360.0
+        lng < -180.0 -> lng + 360.0
+        else -> lng
+    }
+}
@@ -0,0 +1,107 @@
+package org.example.project.geo
+
+import kotlin.math.floor
+
+/**
+ * Standard base32 geohash. Reports store a [STORAGE_PRECISION]-character hash,
+ * so every shorter hash is a prefix of the stored value and a cell lookup is an
+ * index range scan: `geohash >= prefix AND geohash < prefix || '~'`.
+ */
+object Geohash {
+    private const val BASE32 = "0123456789bcdefghjkmnpqrstuvwxyz"
+
+    const val STORAGE_PRECISION = 9   // ~4.8m x 4.8m cells
+    const val MAX_PRECISION = 12
+
+    fun encode(lat: Double, lng: Double, precision: Int = STORAGE_PRECISION): String {
+        require(precision in 1..MAX_PRECISION) { "precision must be in 1..$MAX_PRECISION" }
+        var latMin = -90.0
+        var latMax = 90.0
+        var lngMin = -180.0
+        var lngMax = 180.0
+        val out = StringBuilder(precision)
+        var lngBit = true
+        var bits = 0
+        var ch = 0
+        while (out.length < precision) {
+            ch = ch shl 1
+            if (lngBit) {
+                val mid = (lngMin + lngMax) / 2
+                if (lng >= mid) { ch = ch or 1; lngMin = mid } else lngMax = mid
+            } else {
+                val mid = (latMin + latMax) / 2
+                if (lat >= mid) { ch = ch or 1; latMin = mid } else latMax = mid
+            }
+            lngBit = !lngBit
+            if (++bits == 5) {
+                out.append(BASE32[ch])
+                bits = 0
+                ch = 0
+            }
+        }
+        return out.toString()
+    }
+
+    /** The cell a hash stands for. */
+    fun bounds(hash: String): GeoBounds {
+        var latMin = -90.0
+        var latMax = 90.0
+        var lngMin = -180.0
+        var lngMax = 180.0
+        var lngBit = true
+        for (c in hash) {
+            val v = BASE32.indexOf(c)
+            require(v >= 0) { "invalid geohash character '$c'" }
+            for (shift in 4 downTo 0) {
+                val on = (v shr shift) and 1 == 1
+                if (lngBit) {
+                    val mid = (lngMin + lngMax) / 2
+                    if (on) lngMin = mid else lngMax = mid
+                } else {
+                    val mid = (latMin + latMax) / 2
+                    if (on) latMin = mid else latMax = mid
+                }
+                lngBit = !lngBit
+            }
+        }
+        return GeoBounds(south = latMin, west = lngMin, north = latMax, east = lngMax)
+    }
+
+    /** Height and width in degrees of a cell at [precision]. */
+    fun cellSize(precision: Int): Pair<Double, Double> {
+        val totalBits = 5 * precision
+        val lngBits = (totalBits + 1) / 2
+        val latBits = totalBits / 2
+        return 180.0 / (1L shl latBits) to 360.0 / (1L shl lngBits)
+    }
+
+    /**
+     * The finest set of at most [maxCells] same-precision cells that covers [bounds]
+     * (which must not cross the antimeridian). Empty when even single-character
+     * cells would need more than [maxCells], i.e. the box is close to world-sized.
+     */
+    fun coveringPrefixes(bounds: GeoBounds, maxCells: Int = 16): List<String> {
+        require(!bounds.crossesAntimeridian) { "split the bounds at the antimeridian first" }
+        for (precision in STORAGE_PRECISION downTo 1) {
+            val (cellH, cellW) = cellSize(precision)
+            val maxRow = (180.0 / cellH).toLong() - 1
+            val maxCol = (360.0 / cellW).toLong() - 1
+            val row0 = floor((bounds.south + 90.0) / cellH).toLong().coerceIn(0, maxRow)
+            val row1 = floor((bounds.north + 90.0) / cellH).toLong().coerceIn(0, maxRow)
+            val col0 = floor((bounds.west + 180.0) / cellW).toLong().coerceIn(0, maxCol)
+            val col1 = floor((bounds.east + 180.0) / cellW).toLong().coerceIn(0, maxCol)
+            if ((row1 - row0 + 1) * (col1 - col0 + 1) > maxCells) continue
+
+            val cells = ArrayList<String>()
+            for (row in row0..row1) {
+                for (col in col0..col1) {
+                    val lat = -90.0 + (row + 0.5) * cellH
+                    val lng = -180.0 + (col + 0.5) * cellW
+                    cells += encode(lat, lng, precision)
+                }
+            }
+            return cells
+        }
+        return emptyList()
+    }
+}
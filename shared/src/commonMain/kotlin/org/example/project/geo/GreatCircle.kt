@@ -0,0 +1,58 @@
+package org.example.project.geo
+
+import kotlin.math.PI
+import kotlin.math.abs
+import kotlin.math.asin
+import kotlin.math.cos
+import kotlin.math.min
+import kotlin.math.sin
+import kotlin.math.sqrt
+
+/** Mean Earth radius (IUGG), in meters. */
+const val EARTH_RADIUS_M = 6_371_008.8
+
+/** Half the Earth's circumference: no two points are further apart than this. */
+const val MAX_DISTANCE_M = PI * EARTH_RADIUS_M
+
+/** Great-circle distance in meters, by the haversine formula. */
+fun haversineMeters(lat1: Double, lng1: Double, lat2: Double, lng2: Double): Double {
+    val sinLat = sin((lat2 - lat1) * RADIANS / 2)
+    val sinLng = sin((lng2 - lng1) * RADIANS / 2)
+    val a = sinLat * sinLat + cos(lat1 * RADIANS) * cos(lat2 * RADIANS) * sinLng * sinLng
+    return 2 * EARTH_RADIUS_M * asin(sqrt(min(1.0, a)))
+}
+
+/**
+ * Smallest box holding every point within [radiusMeters] of ([lat], [lng]).
+ * A circle that reaches a pole gets the full range of longitudes.
+ */
+fun boundsAround(lat: Double, lng: Double, radiusMeters: Double): GeoBounds {
+    val angle = radiusMeters / EARTH_RADIUS_M
+    val south = lat - angle / RADIANS
+    val north = lat + angle / RADIANS
+    if (south <= -90.0 || north >= 90.0) {
+        return GeoBounds(south.coerceAtLeast(-90.0), -180.0, north.coerceAtMost(90.0), 180.0)
+    }
+    val halfWidth = longitudeHalfWidth(lat * RADIANS, angle)
+    if (halfWidth >= PI) return GeoBounds(south, -180.0, north, 180.0)
+    return GeoBounds(south, wrapLng(lng - halfWidth / RADIANS), north, wrapLng(lng + halfWidth / RADIANS))
+}
+
+/**
+ * Widest longitude offset, in radians, of a circle of [angle] radians around a
+ * point at [latRadians]; it is reached north or south of the centre. [PI] when
+ * the circle reaches a pole and so spans every longitude.
+ */
+internal fun longitudeHalfWidth(latRadians: Double, angle: Double): Double {
+    if (angle >= PI / 2 - abs(latRadians)) return PI
+    val sinHalfWidth = sin(angle) / cos(latRadians)
+    return if (sinHalfWidth >= 1.0) PI else asin(sinHalfWidth)
+}
+
+internal const val RADIANS = PI / 180.0
+
+private fun wrapLng(lng: Double): Double = when {
+    lng > 180.0 -> lng - 360.0
+    lng < -180.0 -> lng + 360.0
+    else -> lng
+}
@@ -0,0 +1,293 @@
+package org.example.project.geo
+
+import kotlin.math.PI
+import kotlin.math.atan
+import kotlin.math.exp
+import kotlin.math.floor
+import kotlin.math.ln
+import kotlin.math.pow
+import kotlin.math.sin
+
+/**
+ * One marker to draw: either a single item ([count] == 1, [item] set) or a
+ * cluster of [count] items centred on their mean position.
+ */
+data class MarkerCluster<T : Any>(
+    val id: Long,               // stable within one index, usable as a UI key
+    val lat: Double,
+    val lng: Double,
+    val count: Int,
+    val item: T?,
+    val expansionZoom: Int      // zoom at which this cluster starts to split
+)
+
+/**
+ * Hierarchical greedy clustering in the style of supercluster.
+ *
+ * Points are projected to Web Mercator once; then, from [maxZoom] down to
+ * [minZoom], every level is clustered from the level above it using a static
+ * KD-tree, so each level costs O(n log n) and the whole build is done up front.
+ * [getClusters] is a range query on the tree of the requested zoom.
+ *
+ * [radiusDp] is the cluster radius on screen, in the units of a 256-wide world
+ * tile (density-independent pixels on Google Maps, points on MapKit).
+ */
+class MarkerClusterIndex<T : Any>(
+    private val items: List<T>,
+    latOf: (T) -> Double,
+    lngOf: (T) -> Double,
+    val minZoom: Int = 0,
+    val maxZoom: Int = 16,
+    private val radiusDp: Double = 48.0
+) {
+    private class Level(
+        val x: DoubleArray,
+        val y: DoubleArray,
+        val count: IntArray,
+        val item: IntArray,         // index into items for single points, -1 for clusters
+        val id: LongArray,
+        val expansionZoom: IntArray
+    ) {
+        val size get() = x.size
+        val tree = KdTree(x, y)
+    }
+
+    // levels[z - minZoom] for z in minZoom..maxZoom + 1; the last one holds the raw points
+    private val levels: Array<Level>
+
+    init {
+        val n = items.size
+        var level = Level(
+            x = DoubleArray(n) { lngX(lngOf(items[it])) },
+            y = DoubleArray(n) { latY(latOf(items[it])) },
+            count = IntArray(n) { 1 },
+            item = IntArray(n) { it },
+            id = LongArray(n) { it.toLong() },
+            expansionZoom = IntArray(n) { maxZoom + 1 }
+        )
+        val built = arrayOfNulls<Level>(maxZoom - minZoom + 2)
+        built[maxZoom - minZoom + 1] = level
+        for (zoom in maxZoom downTo minZoom) {
+            level = cluster(level, zoom)
+            built[zoom - minZoom] = level
+        }
+        @Suppress("UNCHECKED_CAST")
+        levels = built as Array<Level>
+    }
+
+    /** Markers intersecting [bounds] at map [zoom] (fractional zooms are floored). */
+    fun getClusters(bounds: GeoBounds, zoom: Double): List<MarkerCluster<T>> {
+        val z = floor(zoom).toInt().coerceIn(minZoom, maxZoom + 1)
+        val level = levels[z - minZoom]
+        val out = ArrayList<MarkerCluster<T>>()
+        for (box in bounds.splitAtAntimeridian()) {
+            // y grows southwards in Mercator space
+            level.tree.range(lngX(box.west), latY(box.north), lngX(box.east), latY(box.south)) { i ->
+                out += level.toCluster(i)
+            }
+        }
+        return out
+    }
+
+    private fun Level.toCluster(i: Int) = MarkerCluster(
+        id = id[i],
+        lat = yLat(y[i]),
+        lng = xLng(x[i]),
+        count = count[i],
+        item = item[i].takeIf { it >= 0 }?.let { items[it] },
+        expansionZoom = expansionZoom[i]
+    )
+
+    // Greedy pass: each unvisited point absorbs its unvisited neighbours within the radius.
+    private fun cluster(prev: Level, zoom: Int): Level {
+        val r = radiusDp / (TILE_SIZE * 2.0.pow(zoom))
+        val n = prev.size
+        val visited = BooleanArray(n)
+        val x = DoubleArray(n)
+        val y = DoubleArray(n)
+        val count = IntArray(n)
+        val item = IntArray(n)
+        val id = LongArray(n)
+        val expansion = IntArray(n)
+        var size = 0
+
+        for (i in 0 until n) {
+            if (visited[i]) continue
+            visited[i] = true
+
+            var weight = prev.count[i]
+            var wx = prev.x[i] * weight
+            var wy = prev.y[i] * weight
+            var absorbed = false
+            prev.tree.within(prev.x[i], prev.y[i], r) { j ->
+                if (!visited[j]) {
+                    visited[j] = true
+                    val c = prev.count[j]
+                    wx += prev.x[j] * c
+                    wy += prev.y[j] * c
+                    weight += c
+                    absorbed = true
+                }
+            }
+
+            if (absorbed) {
+                x[size] = wx / weight
+                y[size] = wy / weight
+                count[size] = weight
+                item[size] = -1
+                // encodes the source index and zoom, kept clear of point ids
+                id[size] = items.size + (i.toLong() shl 5) + (zoom + 1)
+                expansion[size] = zoom + 1
+            } else {
+                x[size] = prev.x[i]
+                y[size] = prev.y[i]
+                count[size] = prev.count[i]
+                item[size] = prev.item[i]
+                id[size] = prev.id[i]
+                expansion[size] = prev.expansionZoom[i]
+            }
+            size++
+        }
+
+        return Level(
+            x.copyOf(size), y.copyOf(size), count.copyOf(size),
+            item.copyOf(size), id.copyOf(size), expansion.copyOf(size)
+        )
+    }
+
+    private companion object {
+        const val TILE_SIZE = 256.0
+
+        fun lngX(lng: Double) = lng / 360.0 + 0.5
+
+        fun latY(lat: Double): Double {
+            val s = sin(lat * PI / 180.0)
+            val y = 0.5 - 0.25 * ln((1 + s) / (1 - s)) / PI
+            return y.coerceIn(0.0, 1.0)
+        }
+
+        fun xLng(x: Double) = (x - 0.5) * 360.0
+
+        fun yLat(y: Double): Double {
+            val y2 = (180.0 - y * 360.0) * PI / 180.0
+            return 360.0 * atan(exp(y2)) / PI - 90.0
+        }
+    }
+}
+
+/**
+ * Static 2-D KD-tree over parallel coordinate arrays (after kdbush). Points are
+ * never moved: the tree sorts a permutation of their indices.
+ */
+internal class KdTree(
+    private val xs: DoubleArray,
+    private val ys: DoubleArray,
+    private val nodeSize: Int = 64
+) {
+    private val ids = IntArray(xs.size) { it }
+    private val coords = DoubleArray(xs.size * 2).also { c ->
+        for (i in xs.indices) {
+            c[2 * i] = xs[i]
+            c[2 * i + 1] = ys[i]
+        }
+    }
+
+    init {
+        if (ids.isNotEmpty()) sort(0, ids.size - 1, 0)
+    }
+
+    /** Calls [visit] with the index of every point inside the box. */
+    fun range(minX: Double, minY: Double, maxX: Double, maxY: Double, visit: (Int) -> Unit) {
+        if (ids.isEmpty()) return
+        val stack = IntArray(STACK_SIZE)
+        var top = 0
+        stack[top++] = 0; stack[top++] = ids.size - 1; stack[top++] = 0
+        while (top > 0) {
+            val axis = stack[--top]
+            val right = stack[--top]
+            val left = stack[--top]
+
+            if (right - left <= nodeSize) {
+                for (i in left..right) {
+                    val x = coords[2 * i]
+                    val y = coords[2 * i + 1]
+                    if (x >= minX && x <= maxX && y >= minY && y <= maxY) visit(ids[i])
+                }
+                continue
+            }
+
+            val m = (left + right) ushr 1
+            val x = coords[2 * m]
+            val y = coords[2 * m + 1]
+            if (x >= minX && x <= maxX && y >= minY && y <= maxY) visit(ids[m])
+
+            if (if (axis == 0) minX <= x else minY <= y) {
+                stack[top++] = left; stack[top++] = m - 1; stack[top++] = 1 - axis
+            }
+            if (if (axis == 0) maxX >= x else maxY >= y) {
+                stack[top++] = m + 1; stack[top++] = right; stack[top++] = 1 - axis
+            }
+        }
+    }
+
+    /** Calls [visit] with the index of every point within [r] of ([qx], [qy]). */
+    fun within(qx: Double, qy: Double, r: Double, visit: (Int) -> Unit) {
+        val r2 = r * r
+        range(qx - r, qy - r, qx + r, qy + r) { i ->
+            val dx = xs[i] - qx
+            val dy = ys[i] - qy
+            if (dx * dx + dy * dy <= r2) visit(i)
+        }
+    }
+
+    private fun sort(left: Int, right: Int, axis: Int) {
+        if (right - left <= nodeSize) return
+        val m = (left + right) ushr 1
+        select(m, left, right, axis)
+        sort(left, m - 1, 1 - axis)
+        sort(m + 1, right, 1 - axis)
+    }
+
+    // Quickselect: puts the k-th smallest coordinate on [axis] at k, smaller ones before it.
+    private fun select(k: Int, leftStart: Int, rightStart: Int, axis: Int) {
+        var left = leftStart
+        var right = rightStart
+        while (right > left) {
+            val t = coords[2 * k + axis]
+            var i = left
+            var j = right
+
+            swap(left, k)
+            if (coords[2 * right + axis] > t) swap(left, right)
+
+            while (i < j) {
+                swap(i, j)
+                i++
+                j--
+                while (coords[2 * i + axis] < t) i++
+                while (coords[2 * j + axis] > t) j--
+            }
+
+            if (coords[2 * left + axis] == t) {
+                swap(left, j)
+            } else {
+                j++
+                swap(j, right)
+            }
+
+            if (j <= k) left = j + 1
+            if (k <= j) right = j - 1
+        }
+    }
+
+    private fun swap(i: Int, j: Int) {
+        val id = ids[i]; ids[i] = ids[j]; ids[j] = id
+        val x = coords[2 * i]; coords[2 * i] = coords[2 * j]; coords[2 * j] = x
+        val y = coords[2 * i + 1]; coords[2 * i + 1] = coords[2 * j + 1]; coords[2 * j + 1] = y
+    }
+
+    private companion object {
+        // 3 ints per pending node; depth is bounded by log2(2^31 / nodeSize)
+        const val STACK_SIZE = 3 * 64
+    }
+}
@@ -0,0 +1,88 @@
+package org.example.project.image
+
+import kotlin.math.max
+import kotlin.math.roundToInt
+
+/**
+ * Limits for photos before upload: the longest edge in pixels, and a JPEG size
+ * budget that the encoder meets by lowering quality, never below [minQuality].
+ */
+data class ImagePreprocessConfig(
+    val maxEdgePx: Int = 2048,
+    val targetBytes: Int = 500_000,
+    val minQuality: Int = 50,
+    val maxQuality: Int = 85
+) {
+    companion object {
+        val DEFAULT = ImagePreprocessConfig()
+
+        // Cellular and other metered links: a few hundred KB still fills a phone screen.
+        val METERED = ImagePreprocessConfig(maxEdgePx = 1600, targetBytes = 300_000)
+    }
+}
+
+/**
+ * Decodes a photo subsampled, scales it to [ImagePreprocessConfig.maxEdgePx],
+ * applies its EXIF orientation and re-encodes it as a metadata-free JPEG within
+ * the byte budget. Runs off the main thread.
+ */
+expect class ImagePreprocessor(config: ImagePreprocessConfig = ImagePreprocessConfig.DEFAULT) {
+    suspend fun preprocess(bytes: ByteArray): ByteArray
+}
+
+/** Platform-independent arithmetic of [ImagePreprocessor]. */
+object ImageSizing {
+    private const val QUALITY_STEP = 5
+
+    /**
+     * Largest power-of-two decoder subsample that keeps the longest edge at or
+     * above [maxEdge], so the final resize only ever scales down.
+     */
+    fun sampleSize(width: Int, height: Int, maxEdge: Int): Int {
+        val edge = max(width, height)
+        var sample = 1
+        while (edge / (sample * 2) >= maxEdge) sample *= 2
+        return sample
+    }
+
+    /** [width] x [height] scaled down, aspect kept, so the longest edge is at most [maxEdge]. */
+    fun fit(width: Int, height: Int, maxEdge: Int): Pair<Int, Int> {
+        val edge = max(width, height)
+        if (edge <= maxEdge) return width to height
+        val scale = maxEdge.toDouble() / edge
+        return max(1, (width * scale).roundToInt()) to max(1, (height * scale).roundToInt())
+    }
+
+    /**
+     * The highest-quality encoding that fits [ImagePreprocessConfig.targetBytes].
+     * Qualities are tried in steps of 5 by binary search, so a miss at the top
+     * costs about four extra encodes. Returns the [ImagePreprocessConfig.minQuality]
+     * encoding when nothing fits.
+     */
+    fun <T> encodeWithinBudget(
+        config: ImagePreprocessConfig,
+        encode: (quality: Int) -> T,
+        sizeOf: (T) -> Int
+    ): T {
+        val top = encode(config.maxQuality)
+        if (sizeOf(top) <= config.targetBytes) return top
+
+        val levels = (config.minQuality until config.maxQuality step QUALITY_STEP).toList()
+        var lo = 0
+        var hi = levels.lastIndex
+        var fit: T? = null
+        var atMin: T? = null
+        while (lo <= hi) {
+            val mid = (lo + hi) ushr 1
+            val out = encode(levels[mid])
+            if (mid == 0) atMin = out
+            if (sizeOf(out) <= config.targetBytes) {
+                fit = out
+                lo = mid + 1
+            } else {
+                hi = mid - 1
+            }
+        }
+        return fit ?: atMin ?: top
+    }
+}
@@ -0,0 +1,100 @@
+package org.example.project.image
+
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.catch
+import kotlinx.coroutines.flow.channelFlow
+import kotlinx.coroutines.flow.conflate
+import kotlinx.coroutines.flow.filterIsInstance
+import kotlinx.coroutines.flow.first
+import kotlinx.coroutines.flow.launchIn
+import kotlinx.coroutines.flow.onEach
+import kotlinx.coroutines.sync.Semaphore
+import kotlinx.coroutines.sync.withPermit
+import org.example.project.Closeable
+import org.example.project.IOScope
+
+/** Where an upload is; the flow of an upload ends with [Done] or throws. */
+sealed interface UploadProgress {
+    /** Waiting for a free slot in the upload queue. */
+    data object Queued : UploadProgress
+
+    data class Sending(val sentBytes: Long, val totalBytes: Long) : UploadProgress {
+        val fraction: Float get() = if (totalBytes <= 0) 0f else sentBytes.toFloat() / totalBytes
+    }
+
+    data class Done(val url: String) : UploadProgress
+}
+
+/**
+ * Uploads report photos. Each [upload] is cold: collecting it starts the upload and
+ * cancelling the collector cancels it, including the request already on the wire.
+ */
+interface ImageUploader {
+    fun upload(image: ByteArray): Flow<UploadProgress>
+}
+
+/** Hosted URL of [image] once uploaded, for callers that do not show progress. */
+suspend fun ImageUploader.awaitUrl(image: ByteArray): String =
+    upload(image).filterIsInstance<UploadProgress.Done>().first().url
+
+/**
+ * Callback form of [ImageUploader.upload] for Swift. Callbacks run on the main
+ * thread; [close] cancels the upload.
+ */
+fun ImageUploader.start(
+    image: ByteArray,
+    onProgress: (UploadProgress) -> Unit,
+    onError: (Throwable) -> Unit
+): Closeable {
+    val job = upload(image)
+        .onEach { onProgress(it) }
+        .catch { onError(it) }
+        .launchIn(IOScope.scope)
+    return object : Closeable {
+        override fun close() = job.cancel()
+    }
+}
+
+/** Moves bytes to the image host and returns the hosted URL. */
+fun interface UploadTransport {
+    /**
+     * Sends [bytes], reporting progress through [onProgress] (from any thread).
+     * Must stop the request when the calling coroutine is cancelled.
+     */
+    suspend fun send(bytes: ByteArray, onProgress: (sentBytes: Long, totalBytes: Long) -> Unit): String
+}
+
+/** The app's image host: Cloudinary, through each platform's SDK. */
+expect class CloudinaryTransport() : UploadTransport {
+    override suspend fun send(bytes: ByteArray, onProgress: (sentBytes: Long, totalBytes: Long) -> Unit): String
+}
+
+/**
+ * [ImageUploader] that preprocesses each photo and then sends at most [maxParallel]
+ * at a time through [transport]; the rest wait as [UploadProgress.Queued].
+ * Preprocessing runs outside the queue, so the next photo is ready the moment a
+ * slot frees up.
+ */
+class QueuedImageUploader(
+    private val transport: UploadTransport,
+    private val preprocessor: () -> ImagePreprocessor? = { ImagePreprocessor() },
+    maxParallel: Int = DEFAULT_PARALLEL_UPLOADS
+) : ImageUploader {
+    private val slots = Semaphore(maxParallel)
+
+    override fun upload(image: ByteArray): Flow<UploadProgress> = channelFlow {
+        send(UploadProgress.Queued)
+        val prepared = preprocessor()?.preprocess(image) ?: image
+        val url = slots.withPermit {
+            send(UploadProgress.Sending(0, prepared.size.toLong()))
+            transport.send(prepared) { sent, total -> trySend(UploadProgress.Sending(sent, total)) }
+        }
+        send(UploadProgress.Done(url))
+    }.conflate()   // a slow collector sees the latest progress, never a backlog
+
+    companion object {
+        // Enough to overlap one upload's handshake with another's transfer without
+        // splitting a phone's uplink so thin that every photo finishes late.
+        const val DEFAULT_PARALLEL_UPLOADS = 3
+    }
+}
@@ -0,0 +1,51 @@
+package org.example.project.image
+
+import kotlin.math.ceil
+import kotlin.math.max
+import kotlin.math.roundToInt
+
+/**
+ * Rewrites Cloudinary delivery URLs (`secure_url`) to fetch an image at the size
+ * it is drawn, with `q_auto` and `f_auto` so the CDN picks quality and format.
+ * Other URLs are returned unchanged.
+ *
+ * Pixel widths round up to a fixed set of buckets, so every screen asks for one
+ * of a few variants per image and the CDN cache stays warm.
+ */
+object ImageUrlBuilder {
+    private const val UPLOAD_PATH = "/image/upload/"
+    private const val HOST = "res.cloudinary.com"
+
+    // Physical pixels
+    private val WIDTH_BUCKETS = intArrayOf(64, 96, 128, 192, 256, 384, 512, 768, 1024, 1280, 1600, 2048)
+    private val TRANSFORMATION = Regex("$PARAM(,$PARAM)*")
+    private const val PARAM = "(a|ar|b|c|d|dpr|e|f|fl|g|h|o|q|r|t|w|x|y|z)_[^,/]+"
+
+    /**
+     * [url] for a [widthDp] x [heightDp] slot on a screen of [density] pixels per
+     * dp (points and scale on iOS), cropped to fill it. Pass a [heightDp] of 0 to
+     * keep the original aspect ratio.
+     */
+    fun sized(url: String, widthDp: Double, heightDp: Double, density: Double): String {
+        val at = url.indexOf(UPLOAD_PATH)
+        if (at < 0 || !url.contains(HOST) || widthDp <= 0.0) return url
+        val rest = url.substring(at + UPLOAD_PATH.length)
+        // already transformed, e.g. by an earlier call: leave it as it is
+        if (TRANSFORMATION.matches(rest.substringBefore('/'))) return url
+
+        val width = bucket(ceil(widthDp * density).toInt())
+        val transformation = buildString {
+            if (heightDp > 0.0) {
+                val height = max(1, (width * heightDp / widthDp).roundToInt())
+                append("c_fill,g_auto,w_").append(width).append(",h_").append(height)
+            } else {
+                append("c_limit,w_").append(width)
+            }
+            append(",q_auto,f_auto")
+        }
+        return url.substring(0, at + UPLOAD_PATH.length) + transformation + "/" + rest
+    }
+
+    private fun bucket(px: Int): Int =
+        WIDTH_BUCKETS.firstOrNull { it >= px } ?: WIDTH_BUCKETS.last()
+}
@@ -0,0 +1,86 @@
+package org.example.project.image
+
+import kotlinx.coroutines.flow.MutableStateFlow
+import kotlinx.coroutines.flow.StateFlow
+import kotlinx.coroutines.flow.asStateFlow
+import kotlinx.coroutines.flow.update
+import kotlin.math.abs
+import kotlin.math.roundToInt
+
+/** One image worth warming, with the size it will be drawn at. */
+data class PrefetchCandidate(val url: String, val widthPx: Int, val heightPx: Int) {
+    // Decoded ARGB_8888 size: what the image costs in the memory cache.
+    val estimatedBytes: Long get() = widthPx.toLong() * heightPx * 4
+}
+
+/**
+ * Decides which images to warm next. Candidates come in order of likelihood;
+ * the plan keeps at most [maxAhead] of them within [byteBudget] bytes.
+ */
+class PrefetchPlanner(
+    val maxAhead: Int = 8,
+    val byteBudget: Long = 8L * 1024 * 1024
+) {
+    fun plan(candidates: List<PrefetchCandidate>): List<PrefetchCandidate> {
+        val out = ArrayList<PrefetchCandidate>(minOf(candidates.size, maxAhead))
+        val seen = HashSet<String>()
+        var bytes = 0L
+        for (candidate in candidates) {
+            if (out.size == maxAhead) break
+            if (candidate.url.isBlank() || !seen.add(candidate.url)) continue
+            if (bytes + candidate.estimatedBytes > byteBudget) break
+            bytes += candidate.estimatedBytes
+            out += candidate
+        }
+        return out
+    }
+
+    /**
+     * Indices of list items to warm, most likely first, for a list showing
+     * [firstVisible]..[lastVisible] of [itemCount] items and scrolling at
+     * [velocity] items per second (positive = towards the end).
+     *
+     * Looks further ahead the faster the list moves, and not at all during a
+     * fling faster than [FLING_ITEMS_PER_SECOND]: the user will not stop on
+     * anything it passes, and the fetches would only compete with the ones
+     * for where it lands.
+     */
+    fun listAhead(firstVisible: Int, lastVisible: Int, itemCount: Int, velocity: Double): List<Int> {
+        if (itemCount == 0 || abs(velocity) > FLING_ITEMS_PER_SECOND) return emptyList()
+        val ahead = (BASE_AHEAD + abs(velocity) * LOOKAHEAD_SECONDS).roundToInt().coerceAtMost(maxAhead)
+        return if (velocity >= 0) {
+            (lastVisible + 1..minOf(itemCount - 1, lastVisible + ahead)).toList()
+        } else {
+            (firstVisible - 1 downTo maxOf(0, firstVisible - ahead)).toList()
+        }
+    }
+
+    companion object {
+        const val BASE_AHEAD = 3
+        const val LOOKAHEAD_SECONDS = 0.5
+        const val FLING_ITEMS_PER_SECOND = 40.0
+    }
+}
+
+/** Counters for tuning the prefetcher: did images arrive from a warm cache when shown? */
+class PrefetchStats {
+    data class Snapshot(
+        val started: Int = 0,
+        val completed: Int = 0,
+        val cancelled: Int = 0,
+        val hits: Int = 0,      // shown from the memory or disk cache
+        val misses: Int = 0     // shown only after a network fetch
+    ) {
+        val hitRate: Double get() = if (hits + misses == 0) 0.0 else hits.toDouble() / (hits + misses)
+    }
+
+    private val _snapshot = MutableStateFlow(Snapshot())
+    val snapshot: StateFlow<Snapshot> = _snapshot.asStateFlow()
+
+    fun started() = _snapshot.update { it.copy(started = it.started + 1) }
+    fun completed() = _snapshot.update { it.copy(completed = it.completed + 1) }
+    fun cancelled() = _snapshot.update { it.copy(cancelled = it.cancelled + 1) }
+    fun shown(fromCache: Boolean) = _snapshot.update {
+        if (fromCache) it.copy(hits = it.hits + 1) else it.copy(misses = it.misses + 1)
+    }
+}
@@ -0,0 +1,73 @@
+package org.example.project
+
+import kotlinx.coroutines.flow.MutableSharedFlow
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.test.advanceTimeBy
+import kotlinx.coroutines.test.runCurrent
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+class FlowObservationTest {
+
+    @Test
+    fun burstIsFoldedIntoOneDeliveryPerInterval() = runTest {
+        val source = MutableSharedFlow<Int>(extraBufferCapacity = 100)
+        val seen = mutableListOf<List<Int>>()
+        val observation = source.observeIn(backgroundScope, ObserveOptions(minIntervalMs = 100)) { seen += it }
+        runCurrent()
+
+        source.tryEmit(0)
+        runCurrent()
+        repeat(50) { source.tryEmit(it + 1) }
+        advanceTimeBy(101)
+
+        assertEquals(listOf(listOf(0), listOf(50)), seen)
+        assertEquals(51, observation.received)
+        assertEquals(2, observation.delivered)
+        assertEquals(49, observation.coalesced)
+        observation.close()
+    }
+
+    @Test
+    fun unconflatedBatchesKeepEveryValueInOrder() = runTest {
+        val source = MutableSharedFlow<Int>(extraBufferCapacity = 100)
+        val seen = mutableListOf<List<Int>>()
+        source.observeIn(backgroundScope, ObserveOptions(conflate = false, minIntervalMs = 100)) { seen += it }
+        runCurrent()
+
+        launch {
+            repeat(10) {
+                source.emit(it)
+                delay(30)
+            }
+        }
+        advanceTimeBy(1_000)
+
+        assertEquals((0 until 10).toList(), seen.flatten())
+        assertEquals(4, seen.size)
+    }
+
+    @Test
+    fun distinctDropsRepeatsAndReturnsToTheDeliveredValue() = runTest {
+        val source = MutableSharedFlow<String>(extraBufferCapacity = 10)
+        val seen = mutableListOf<String>()
+        val observation = source.observeIn(backgroundScope, ObserveOptions(minIntervalMs = 100)) { seen += it.last() }
+        runCurrent()
+
+        source.tryEmit("idle")
+        runCurrent()
+        source.tryEmit("idle")
+        source.tryEmit("saving")
+        source.tryEmit("idle")   // back where the last delivery left it
+        advanceTimeBy(101)
+        source.tryEmit("saved")
+        runCurrent()
+
+        assertEquals(listOf("idle", "saved"), seen)
+        assertEquals(5, observation.received)
+        assertEquals(2, observation.batches)
+        observation.close()
+    }
+}
@@ -0,0 +1,37 @@
+package org.example.project
+
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+class SingleFlightTest {
+    private var now = 0L
+
+    @Test
+    fun freshResultIsReusedAndExpiredOneIsDropped() = runTest {
+        val flight = SingleFlight<String, Int>(backgroundScope, retainMs = 1_000) { now }
+        var calls = 0
+
+        flight.get("a", maxAgeMs = 1_000) { ++calls }
+        now = 500
+        assertEquals(1, flight.get("a", maxAgeMs = 1_000) { ++calls })
+
+        now = 2_000
+        assertEquals(2, flight.get("a", maxAgeMs = 0) { ++calls })
+        assertEquals(1, flight.cachedCount)
+    }
+
+    @Test
+    fun keysNobodyAsksForAgainAreSwept() = runTest {
+        val flight = SingleFlight<String, Int>(backgroundScope, retainMs = 1_000) { now }
+
+        repeat(1_000) { i ->
+            now = i * 100L   // every key is looked up once, at a different time
+            flight.get("bounds-$i", maxAgeMs = 1_000) { i }
+        }
+
+        // only the last second of keys, plus at most one sweep interval of stragglers
+        assertTrue(flight.cachedCount < 200, "${flight.cachedCount} results held")
+    }
+}
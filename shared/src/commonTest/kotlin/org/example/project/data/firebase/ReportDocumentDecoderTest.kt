@@ -0,0 +1,58 @@
+package org.example.project.data.firebase
+
+import org.example.project.data.report.ReportModel
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+class ReportDocumentDecoderTest {
+
+    @Test
+    fun decodesCleanDocument() {
+        val report = ReportDocumentDecoder.decode(
+            "r1",
+            mapOf(
+                "userId" to "u1", "description" to "brown lab", "name" to "Dana", "phone" to "050",
+                "imageUrl" to "https://x/y.jpg", "isLost" to true, "location" to "Haifa",
+                "lat" to 32.8, "lng" to 34.98, "createdAt" to 1_000L, "updatedAt" to 2_000L, "deleted" to false
+            )
+        )
+        assertEquals(
+            ReportModel(
+                id = "r1", userId = "u1", description = "brown lab", name = "Dana", phone = "050",
+                imageUrl = "https://x/y.jpg", isLost = true, location = "Haifa",
+                lat = 32.8, lng = 34.98, createdAt = 1_000L, updatedAt = 2_000L
+            ),
+            report
+        )
+    }
+
+    @Test
+    fun coercesLegacyTypes() {
+        val report = ReportDocumentDecoder.decode(
+            "r2",
+            mapOf(
+                "lat" to "32.5", "lng" to 35, "createdAt" to 1_500.0, "updatedAt" to "2000",
+                "phone" to 501234567L, "isLost" to "true", "deleted" to 1L
+            )
+        )
+        assertEquals(32.5, report.lat)
+        assertEquals(35.0, report.lng)
+        assertEquals(1_500L, report.createdAt)
+        assertEquals(2_000L, report.updatedAt)
+        assertEquals("501234567", report.phone)
+        assertTrue(report.isLost)
+        assertTrue(report.deleted)
+    }
+
+    @Test
+    fun fallsBackToDefaultsForMissingOrUnusableFields() {
+        val report = ReportDocumentDecoder.decode(
+            "r3",
+            mapOf("lat" to "north", "lng" to null, "createdAt" to mapOf("seconds" to 1), "location" to listOf(1, 2), "extra" to 7)
+        )
+        assertEquals(ReportModel(id = "r3"), report.copy(lat = Double.NaN, lng = Double.NaN))
+        assertTrue(report.lat.isNaN() && report.lng.isNaN())
+        assertEquals(0L, report.createdAt)
+    }
+}
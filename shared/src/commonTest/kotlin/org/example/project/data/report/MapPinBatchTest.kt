@@ -0,0 +1,54 @@
+package org.example.project.data.report
+
+import org.example.project.geo.GeoBounds
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+class MapPinBatchTest {
+
+    @Test
+    fun columnsGrowAndReadBackEveryPin() {
+        val reports = List(40) { i ->
+            ReportModel(id = "r$i", name = if (i % 2 == 0) "כלב $i" else "", isLost = i % 3 == 0,
+                imageUrl = if (i % 5 == 0) "https://img/$i.jpg" else "", lat = 32.0 + i, lng = 34.0 - i)
+        }
+
+        val pins = MapPinBatch.Builder(capacity = 1).apply {
+            reports.forEach { add(it.id, it.lat, it.lng, it.isLost, it.name, it.imageUrl) }
+        }.build()
+
+        assertEquals(reports.size, pins.size)
+        reports.forEachIndexed { i, report ->
+            assertEquals(report.id, pins.id(i))
+            assertEquals(report.name, pins.label(i))
+            assertEquals(report.lat, pins.lat(i))
+            assertEquals(report.lng, pins.lng(i))
+            assertEquals(report.isLost, pins.isLost(i))
+            assertEquals(report.imageUrl.isNotEmpty(), pins.hasImage(i))
+        }
+        assertEquals(3 * reports.size + 1, pins.stringOffsets.size)
+    }
+
+    @Test
+    fun reportsWithoutCoordinatesGetNoPin() {
+        val pins = listOf(
+            ReportModel(id = "a", lat = 32.0, lng = 34.0),
+            ReportModel(id = "b", lat = Double.NaN, lng = Double.NaN)
+        ).toMapPinBatch()
+
+        assertEquals(listOf("a"), List(pins.size) { pins.id(it) })
+        assertTrue(MapPinBatch.EMPTY.strings.isEmpty())
+    }
+
+    @Test
+    fun clusterItemsIndexThePins() {
+        val pins = listOf(ReportModel(id = "a", lat = 32.0, lng = 34.0), ReportModel(id = "b", lat = -33.0, lng = 151.0))
+            .toMapPinBatch()
+
+        val single = mapPinClusterIndex(pins).getClusters(GeoBounds(-90.0, -180.0, 90.0, 180.0), 10.0)
+            .mapNotNull { it.item }
+            .map { pins.id(it) }
+        assertEquals(setOf("a", "b"), single.toSet())
+    }
+}
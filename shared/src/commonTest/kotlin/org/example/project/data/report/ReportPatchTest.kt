@@ -0,0 +1,21 @@
+package org.example.project.data.report
+
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+class ReportPatchTest {
+
+    @Test
+    fun laterEditsWinFieldByField() {
+        val folded = ReportPatch(description = "first", phone = "050")
+            .then(ReportPatch(description = "second", isLost = true))
+        assertEquals(ReportPatch(description = "second", phone = "050", isLost = true), folded)
+    }
+
+    @Test
+    fun applyKeepsFieldsThePatchDoesNotSet() {
+        val report = ReportModel(id = "r1", name = "Cat", description = "Grey", lat = 32.0, lng = 34.0)
+        val patched = ReportPatch(description = "Black", lat = 31.5).applyTo(report)
+        assertEquals(report.copy(description = "Black", lat = 31.5), patched)
+    }
+}
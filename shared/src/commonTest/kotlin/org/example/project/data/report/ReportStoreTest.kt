@@ -0,0 +1,51 @@
+package org.example.project.data.report
+
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertNull
+
+class ReportStoreTest {
+    private val store = ReportStore(capacity = 3) { error("not used by get") }
+
+    @Test
+    fun leastRecentlyUsedReportIsEvicted() {
+        store.putAll(listOf(ReportModel(id = "a"), ReportModel(id = "b"), ReportModel(id = "c")))
+        store.get("a")   // now the most recent
+
+        store.put(ReportModel(id = "d"))
+
+        assertNull(store.get("b"))
+        assertEquals(listOf("a", "c", "d"), listOf("a", "c", "d").mapNotNull { store.get(it)?.id })
+    }
+
+    @Test
+    fun aNewestFirstListLargerThanTheStoreKeepsItsHead() {
+        store.put(ReportModel(id = "older"))
+        val newestFirst = List(5) { ReportModel(id = "r${4 - it}", createdAt = 4L - it) }   // r4, r3, ..., r0
+
+        store.putAll(newestFirst)
+
+        assertEquals(listOf("r4", "r3", "r2"), newestFirst.mapNotNull { store.get(it.id)?.id })
+        assertNull(store.get("older"))
+    }
+
+    @Test
+    fun theFirstEntryOfAListIsTheMostRecent() {
+        store.putAll(listOf(ReportModel(id = "top"), ReportModel(id = "middle"), ReportModel(id = "bottom")))
+
+        store.put(ReportModel(id = "new"))
+
+        assertNull(store.get("bottom"))
+        assertEquals("top", store.get("top")?.id)
+    }
+
+    @Test
+    fun updatesReplaceAndRemovesForget() {
+        store.put(ReportModel(id = "a", name = "Rex"))
+        store.put(ReportModel(id = "a", name = "Max"))
+        assertEquals("Max", store.get("a")?.name)
+
+        store.remove("a")
+        assertNull(store.get("a"))
+    }
+}
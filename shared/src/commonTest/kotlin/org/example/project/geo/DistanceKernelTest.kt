@@ -0,0 +1,88 @@
+package org.example.project.geo
+
+import kotlin.math.abs
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertContentEquals
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+class DistanceKernelTest {
+    private val random = Random(11)
+
+    // Israel plus a band around the antimeridian and one near the north pole
+    private val lats = DoubleArray(3_000) { i ->
+        when (i % 3) {
+            0 -> 29.5 + random.nextDouble() * 3.8
+            1 -> -10.0 + random.nextDouble() * 20.0
+            else -> 85.0 + random.nextDouble() * 5.0
+        }
+    }
+    private val lngs = DoubleArray(lats.size) { i ->
+        when (i % 3) {
+            0 -> 34.2 + random.nextDouble() * 1.7
+            1 -> if (random.nextBoolean()) 179.0 + random.nextDouble() else -180.0 + random.nextDouble()
+            else -> -180.0 + random.nextDouble() * 360.0
+        }
+    }
+    private val points = GeoPoints(lats, lngs)
+
+    @Test
+    fun haversineMatchesThePerPointFormula() {
+        val out = DoubleArray(points.size)
+        for ((lat, lng) in listOf(32.08 to 34.78, 0.0 to 179.9, 89.0 to 0.0)) {
+            DistanceKernel.haversine(points, lat, lng, out)
+            for (i in 0 until points.size) {
+                val expected = haversineMeters(lat, lng, lats[i], lngs[i])
+                assertTrue(abs(out[i] - expected) < 1e-6 * expected + 1e-3, "point $i: ${out[i]} vs $expected")
+            }
+        }
+    }
+
+    @Test
+    fun equirectangularIsCloseAtCityScale() {
+        val out = DoubleArray(points.size)
+        DistanceKernel.equirectangular(points, 32.08, 34.78, out)
+        for (i in 0 until points.size step 3) {
+            val exact = haversineMeters(32.08, 34.78, lats[i], lngs[i])
+            if (exact < 20_000) assertTrue(abs(out[i] - exact) < 0.01 * exact + 1.0)
+        }
+    }
+
+    @Test
+    fun withinRadiusFindsExactlyThePointsInTheCircle() {
+        val indices = IntArray(points.size)
+        val distances = DoubleArray(points.size)
+        for ((lat, lng, radius) in listOf(
+            Triple(32.08, 34.78, 25_000.0),
+            Triple(0.0, 180.0, 500_000.0),       // straddles the antimeridian
+            Triple(89.5, 45.0, 300_000.0),       // reaches over the pole
+            Triple(32.08, 34.78, 0.0)
+        )) {
+            val found = DistanceKernel.withinRadius(points, lat, lng, radius, indices, distances)
+            val expected = (0 until points.size).filter { haversineMeters(lat, lng, lats[it], lngs[it]) <= radius }
+            assertContentEquals(expected.toIntArray(), indices.copyOf(found))
+            for (j in 0 until found) {
+                assertEquals(haversineMeters(lat, lng, lats[indices[j]], lngs[indices[j]]), distances[j], 1e-3)
+            }
+        }
+    }
+
+    @Test
+    fun nearestRanksByDistance() {
+        val nearest = DistanceKernel.nearest(points, 32.08, 34.78, k = 10, maxRadiusMeters = 100_000.0)
+        val expected = (0 until points.size)
+            .map { it to haversineMeters(32.08, 34.78, lats[it], lngs[it]) }
+            .filter { it.second <= 100_000.0 }
+            .sortedBy { it.second }
+            .take(10)
+            .map { it.first }
+        assertContentEquals(expected.toIntArray(), nearest)
+    }
+
+    @Test
+    fun pointsWithoutCoordinatesNeverMatch() {
+        val points = GeoPoints(doubleArrayOf(Double.NaN, 32.08), doubleArrayOf(Double.NaN, 34.78))
+        assertContentEquals(intArrayOf(1), DistanceKernel.nearest(points, 32.08, 34.78, k = 5, maxRadiusMeters = MAX_DISTANCE_M))
+    }
+}
@@ -0,0 +1,26 @@
+package org.example.project.geo
+
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+class GeohashTest {
+
+    @Test
+    fun encodesKnownPoint() {
+        assertEquals("u4pruydqqvj", Geohash.encode(57.64911, 10.40744, 11))
+    }
+
+    @Test
+    fun coverContainsEveryPointInBox() {
+        val box = GeoBounds(south = 32.05, west = 34.75, north = 32.12, east = 34.82)
+        val cover = Geohash.coveringPrefixes(box)
+        assertTrue(cover.isNotEmpty())
+        for (lat in listOf(32.05, 32.08, 32.12)) {
+            for (lng in listOf(34.75, 34.79, 34.82)) {
+                val hash = Geohash.encode(lat, lng)
+                assertTrue(cover.any { hash.startsWith(it) }, "$hash not covered")
+            }
+        }
+    }
+}
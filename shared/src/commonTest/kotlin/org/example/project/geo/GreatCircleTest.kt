@@ -0,0 +1,60 @@
+package org.example.project.geo
+
+import kotlin.math.PI
+import kotlin.math.abs
+import kotlin.math.asin
+import kotlin.math.atan2
+import kotlin.math.cos
+import kotlin.math.sin
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+class GreatCircleTest {
+
+    @Test
+    fun haversineMatchesKnownDistances() {
+        // Tel Aviv to Jerusalem, about 54 km
+        assertTrue(abs(haversineMeters(32.0853, 34.7818, 31.7683, 35.2137) - 54_000) < 1_000)
+        // a quarter of a meridian
+        assertEquals(MAX_DISTANCE_M / 2, haversineMeters(0.0, 0.0, 90.0, 0.0), 1e-6)
+        // the short way round across the antimeridian
+        assertTrue(haversineMeters(0.0, 179.9, 0.0, -179.9) < 23_000)
+    }
+
+    @Test
+    fun boundsAroundHoldTheWholeCircle() {
+        for ((lat, lng) in listOf(32.08 to 34.78, 60.0 to 179.95, -45.0 to -0.01)) {
+            val box = boundsAround(lat, lng, 10_000.0)
+            for (i in 0 until 360) {
+                val (pLat, pLng) = destination(lat, lng, 9_999.0, i.toDouble())
+                assertTrue(box.contains(pLat, pLng), "($pLat, $pLng) outside $box")
+            }
+        }
+        assertTrue(boundsAround(60.0, 179.95, 10_000.0).crossesAntimeridian)
+    }
+
+    @Test
+    fun circleOverAPoleSpansEveryLongitude() {
+        val box = boundsAround(89.95, 10.0, 10_000.0)
+        assertEquals(GeoBounds(box.south, -180.0, 90.0, 180.0), box)
+        assertEquals(GeoBounds(-90.0, -180.0, 90.0, 180.0), boundsAround(0.0, 0.0, MAX_DISTANCE_M))
+    }
+
+    // Point [meters] from (lat, lng) along initial [bearing] degrees.
+    private fun destination(lat: Double, lng: Double, meters: Double, bearing: Double): Pair<Double, Double> {
+        val rad = PI / 180
+        val d = meters / EARTH_RADIUS_M
+        val lat1 = lat * rad
+        val b = bearing * rad
+        val lat2 = asin(sin(lat1) * cos(d) + cos(lat1) * sin(d) * cos(b))
+        val lng2 = lng * rad + atan2(
+            sin(b) * sin(d) * cos(lat1),
+            cos(d) - sin(lat1) * sin(lat2)
+        )
+        var out = lng2 / rad
+        if (out > 180) out -= 360
+        if (out < -180) out += 360
+        return lat2 / rad to out
+    }
+}
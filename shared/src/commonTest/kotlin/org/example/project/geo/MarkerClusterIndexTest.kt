@@ -0,0 +1,30 @@
+package org.example.project.geo
+
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+class MarkerClusterIndexTest {
+
+    private val points = listOf(
+        32.0800 to 34.7800,
+        32.0801 to 34.7801,
+        32.0802 to 34.7799,
+        31.7700 to 35.2100   // Jerusalem, far from the rest
+    )
+    private val index = MarkerClusterIndex(points, { it.first }, { it.second })
+    private val israel = GeoBounds(south = 29.0, west = 34.0, north = 33.5, east = 36.0)
+
+    @Test
+    fun nearbyPointsMergeWhenZoomedOut() {
+        val clusters = index.getClusters(israel, zoom = 8.0)
+        assertEquals(listOf(1, 3), clusters.map { it.count }.sorted())
+        assertEquals(4, clusters.sumOf { it.count })
+    }
+
+    @Test
+    fun pointsSeparateAboveMaxZoom() {
+        val clusters = index.getClusters(israel, zoom = index.maxZoom + 1.0)
+        assertEquals(4, clusters.size)
+        assertEquals(points.toSet(), clusters.mapNotNull { it.item }.toSet())
+    }
+}
@@ -0,0 +1,51 @@
+package org.example.project.image
+
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+
+/**
+ * Stand-in image host for virtual-time tests: no network, but the timing of
+ * one. Each upload waits [latencyMs], then moves [chunkBytes] at a time at
+ * [bytesPerSecond], reporting progress after every chunk. It also records how
+ * many uploads overlapped, so tests can check the queue's bound.
+ */
+class FakeUploadTransport(
+    private val bytesPerSecond: Long = 256L * 1024,
+    private val latencyMs: Long = 150,
+    private val chunkBytes: Int = 16 * 1024,
+    private val failWhen: (ByteArray) -> Boolean = { false }
+) : UploadTransport {
+    private val mutex = Mutex()
+    private var active = 0
+    private var nextId = 0
+
+    var peakParallel = 0
+        private set
+    var completed = 0
+        private set
+
+    override suspend fun send(bytes: ByteArray, onProgress: (sentBytes: Long, totalBytes: Long) -> Unit): String {
+        val id = mutex.withLock {
+            active++
+            peakParallel = maxOf(peakParallel, active)
+            nextId++
+        }
+        try {
+            delay(latencyMs)
+            val total = bytes.size.toLong()
+            var sent = 0L
+            while (sent < total) {
+                val chunk = minOf(chunkBytes.toLong(), total - sent)
+                delay(chunk * 1000 / bytesPerSecond)
+                sent += chunk
+                onProgress(sent, total)
+            }
+            if (failWhen(bytes)) throw IllegalStateException("Simulated upload failure")
+            mutex.withLock { completed++ }
+            return "https://res.cloudinary.com/fake/image/upload/upload-$id.jpg"
+        } finally {
+            mutex.withLock { active-- }
+        }
+    }
+}
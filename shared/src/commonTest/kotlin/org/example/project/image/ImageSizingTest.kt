@@ -0,0 +1,27 @@
+package org.example.project.image
+
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+class ImageSizingTest {
+
+    @Test
+    fun subsamplesWithoutGoingBelowTheTargetEdge() {
+        assertEquals(2, ImageSizing.sampleSize(4032, 3024, 1600))
+        assertEquals(1, ImageSizing.sampleSize(1200, 900, 1600))
+        assertEquals(1600 to 1200, ImageSizing.fit(4032, 3024, 1600))
+    }
+
+    @Test
+    fun picksHighestQualityWithinBudget() {
+        val config = ImagePreprocessConfig(targetBytes = 62_000, minQuality = 50, maxQuality = 85)
+        val tried = mutableListOf<Int>()
+        val quality = ImageSizing.encodeWithinBudget(
+            config,
+            encode = { q -> q.also { tried += it } },
+            sizeOf = { it * 1_000 }
+        )
+        assertEquals(60, quality)
+        assertEquals(85, tried.first())
+    }
+}
@@ -0,0 +1,24 @@
+package org.example.project.image
+
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+class ImageUrlBuilderTest {
+    private val original = "https://res.cloudinary.com/demo/image/upload/v1712345678/abc123.jpg"
+
+    @Test
+    fun thumbnailIsBucketedToPhysicalPixels() {
+        // 88dp at 2.75x = 242px, rounded up to the 256 bucket
+        assertEquals(
+            "https://res.cloudinary.com/demo/image/upload/c_fill,g_auto,w_256,h_256,q_auto,f_auto/v1712345678/abc123.jpg",
+            ImageUrlBuilder.sized(original, 88.0, 88.0, 2.75)
+        )
+    }
+
+    @Test
+    fun leavesForeignAndTransformedUrlsAlone() {
+        val sized = ImageUrlBuilder.sized(original, 88.0, 88.0, 2.0)
+        assertEquals(sized, ImageUrlBuilder.sized(sized, 400.0, 220.0, 3.0))
+        assertEquals("https://example.com/a.jpg", ImageUrlBuilder.sized("https://example.com/a.jpg", 88.0, 88.0, 2.0))
+    }
+}
@@ -0,0 +1,40 @@
+package org.example.project.image
+
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+class PrefetchPlannerTest {
+    private fun candidate(url: String, px: Int = 100) = PrefetchCandidate(url, px, px)
+
+    @Test
+    fun planDropsDuplicatesAndBlanks() {
+        val plan = PrefetchPlanner().plan(listOf(candidate("a"), candidate(""), candidate("a"), candidate("b")))
+        assertEquals(listOf("a", "b"), plan.map { it.url })
+    }
+
+    @Test
+    fun planStopsAtCountAndByteBudget() {
+        val byCount = PrefetchPlanner(maxAhead = 2).plan(listOf(candidate("a"), candidate("b"), candidate("c")))
+        assertEquals(listOf("a", "b"), byCount.map { it.url })
+
+        // 100x100 ARGB is 40 000 bytes; two fit in 100 000, three do not
+        val byBytes = PrefetchPlanner(byteBudget = 100_000).plan(listOf(candidate("a"), candidate("b"), candidate("c")))
+        assertEquals(listOf("a", "b"), byBytes.map { it.url })
+    }
+
+    @Test
+    fun listAheadFollowsScrollDirection() {
+        val planner = PrefetchPlanner()
+        assertEquals(listOf(6, 7, 8), planner.listAhead(2, 5, 20, 0.0))
+        assertEquals(listOf(1, 0), planner.listAhead(2, 5, 20, -2.0))
+        assertEquals(listOf(18, 19), planner.listAhead(10, 17, 20, 4.0))
+    }
+
+    @Test
+    fun listAheadGrowsWithSpeedAndSkipsFlings() {
+        val planner = PrefetchPlanner(maxAhead = 8)
+        assertEquals(8, planner.listAhead(0, 4, 100, 30.0).size)
+        assertTrue(planner.listAhead(0, 4, 100, 50.0).isEmpty())
+    }
+}
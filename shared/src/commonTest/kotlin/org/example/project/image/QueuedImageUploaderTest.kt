@@ -0,0 +1,70 @@
+package org.example.project.image
+
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.flow.collect
+import kotlinx.coroutines.flow.toList
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.test.advanceTimeBy
+import kotlinx.coroutines.test.currentTime
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertIs
+import kotlin.test.assertTrue
+
+class QueuedImageUploaderTest {
+    private val photo = ByteArray(64 * 1024)
+
+    private fun uploader(transport: UploadTransport, maxParallel: Int = 2) =
+        QueuedImageUploader(transport, preprocessor = { null }, maxParallel = maxParallel)
+
+    @Test
+    fun reportsProgressAndEndsWithUrl() = runTest {
+        val events = uploader(FakeUploadTransport(bytesPerSecond = 64 * 1024, latencyMs = 100))
+            .upload(photo).toList()
+
+        // progress is conflated, so only order and bounds are guaranteed
+        val sent = events.filterIsInstance<UploadProgress.Sending>().map { it.sentBytes }
+        assertTrue(sent.isNotEmpty())
+        assertEquals(sent.sorted(), sent)
+        assertTrue(sent.all { it <= photo.size })
+        assertIs<UploadProgress.Done>(events.last())
+        // 100 ms latency + 64 KB at 64 KB/s
+        assertEquals(1100, currentTime)
+    }
+
+    @Test
+    fun runsAtMostMaxParallelUploads() = runTest {
+        val transport = FakeUploadTransport(bytesPerSecond = 64 * 1024, latencyMs = 0)
+        val queue = uploader(transport, maxParallel = 2)
+
+        val urls = List(5) { async { queue.awaitUrl(photo) } }.awaitAll()
+
+        assertEquals(5, urls.toSet().size)
+        assertEquals(2, transport.peakParallel)
+        // three rounds of one-second uploads
+        assertEquals(3000, currentTime)
+    }
+
+    @Test
+    fun cancellingTheCollectorFreesItsSlot() = runTest {
+        val transport = FakeUploadTransport(bytesPerSecond = 64 * 1024, latencyMs = 0)
+        val queue = uploader(transport, maxParallel = 1)
+
+        val first = launch { queue.upload(photo).collect() }
+        advanceTimeBy(500)
+        first.cancel()
+        queue.awaitUrl(photo)
+
+        assertEquals(1, transport.completed)
+        assertTrue(currentTime < 2000)
+    }
+
+    @Test
+    fun transportFailureFailsTheFlow() = runTest {
+        val queue = uploader(FakeUploadTransport(latencyMs = 0, failWhen = { true }))
+        assertFailsWith<IllegalStateException> { queue.awaitUrl(photo) }
+    }
+}
@@ -0,0 +1,29 @@
+@file:OptIn(kotlinx.cinterop.ExperimentalForeignApi::class)
+package org.example.project.data.firebase
+
+import cocoapods.FirebaseFirestoreInternal.FIRTimestamp
+import dev.gitlive.firebase.firestore.DocumentSnapshot
+import dev.gitlive.firebase.firestore.ios
+import kotlinx.cinterop.toKString
+import platform.Foundation.NSNumber
+
+// NSString arrives as a Kotlin String, but NSNumber does not arrive as a Kotlin number.
+internal actual fun DocumentSnapshot.rawFields(): Map<String, Any?> {
+    val data = ios.data() ?: return emptyMap()
+    val fields = HashMap<String, Any?>(data.size)
+    for ((key, value) in data) {
+        val name = key as? String ?: continue
+        fields[name] = when (value) {
+            is NSNumber -> value.toKotlin()
+            is FIRTimestamp -> value.seconds * 1000 + value.nanoseconds / 1_000_000
+            else -> value
+        }
+    }
+    return fields
+}
+
+private fun NSNumber.toKotlin(): Any = when (objCType?.toKString()) {
+    "c", "B" -> boolValue            // BOOL, and Firestore's booleans
+    "d", "f" -> doubleValue
+    else -> longLongValue
+}
@@ -5,5 +5,5 @@ import app.cash.sqldelight.driver.native.NativeSqliteDriver
 
 actual class DatabaseDriverFactory {
     actual fun createDriver(): SqlDriver =
-        NativeSqliteDriver(AppDatabase.Schema, "app.db")
-}
\ No newline at end of file
+        NativeSqliteDriver(AppDatabase.Schema, "app.db", callbacks = *ReportMigrations.callbacks)
+}
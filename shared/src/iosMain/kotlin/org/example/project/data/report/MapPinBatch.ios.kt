@@ -0,0 +1,29 @@
+@file:OptIn(kotlinx.cinterop.ExperimentalForeignApi::class)
+package org.example.project.data.report
+
+import kotlinx.cinterop.addressOf
+import kotlinx.cinterop.usePinned
+import org.example.project.image.toNSData
+import platform.Foundation.NSData
+import platform.Foundation.create
+
+// Swift reads a KotlinDoubleArray one bridged call per element; these copy each
+// column once into NSData, which Swift reads in place as Data.
+
+/** [MapPinBatch.coordinates] as native-endian Float64 pairs. */
+fun MapPinBatch.coordinatesData(): NSData =
+    if (coordinates.isEmpty()) NSData() else coordinates.usePinned {
+        NSData.create(bytes = it.addressOf(0), length = (coordinates.size * Double.SIZE_BYTES).toULong())
+    }
+
+/** [MapPinBatch.flags], one byte per pin. */
+fun MapPinBatch.flagsData(): NSData = flags.toNSData()
+
+/** [MapPinBatch.strings], the UTF-8 string table. */
+fun MapPinBatch.stringsData(): NSData = strings.toNSData()
+
+/** [MapPinBatch.stringOffsets] as native-endian Int32. */
+fun MapPinBatch.stringOffsetsData(): NSData =
+    stringOffsets.usePinned {
+        NSData.create(bytes = it.addressOf(0), length = (stringOffsets.size * Int.SIZE_BYTES).toULong())
+    }
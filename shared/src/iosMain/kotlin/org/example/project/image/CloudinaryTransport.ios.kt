@@ -0,0 +1,42 @@
+package org.example.project.image
+
+import kotlinx.coroutines.suspendCancellableCoroutine
+import org.example.project.Closeable
+import platform.Foundation.NSData
+import kotlin.coroutines.resume
+import kotlin.coroutines.resumeWithException
+
+/**
+ * The Cloudinary iOS SDK is Swift-only, so Kotlin cannot call it: the app
+ * implements this on top of it and installs it in [CloudinaryTransport.bridge]
+ * at launch. Exactly one of url and error is non-null in [onComplete].
+ */
+interface CloudinaryBridge {
+    fun upload(
+        data: NSData,
+        onProgress: (sentBytes: Long, totalBytes: Long) -> Unit,
+        onComplete: (url: String?, error: String?) -> Unit
+    ): Closeable
+}
+
+actual class CloudinaryTransport actual constructor() : UploadTransport {
+
+    actual override suspend fun send(
+        bytes: ByteArray,
+        onProgress: (sentBytes: Long, totalBytes: Long) -> Unit
+    ): String {
+        val bridge = bridge ?: throw IllegalStateException("CloudinaryTransport.bridge is not installed")
+        val data = bytes.toNSData()
+        return suspendCancellableCoroutine { cont ->
+            val request = bridge.upload(data, onProgress) { url, error ->
+                if (url != null) cont.resume(url)
+                else cont.resumeWithException(IllegalStateException(error ?: "Upload failed"))
+            }
+            cont.invokeOnCancellation { request.close() }
+        }
+    }
+
+    companion object {
+        var bridge: CloudinaryBridge? = null
+    }
+}
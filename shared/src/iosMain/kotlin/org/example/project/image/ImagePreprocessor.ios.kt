@@ -0,0 +1,94 @@
+@file:OptIn(kotlinx.cinterop.ExperimentalForeignApi::class)
+package org.example.project.image
+
+import kotlinx.cinterop.addressOf
+import kotlinx.cinterop.usePinned
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.withContext
+import platform.CoreFoundation.CFDataRef
+import platform.CoreFoundation.CFDictionaryCreateMutable
+import platform.CoreFoundation.CFDictionarySetValue
+import platform.CoreFoundation.CFRelease
+import platform.CoreFoundation.kCFBooleanTrue
+import platform.CoreFoundation.kCFTypeDictionaryKeyCallBacks
+import platform.CoreFoundation.kCFTypeDictionaryValueCallBacks
+import platform.CoreGraphics.CGImageGetHeight
+import platform.CoreGraphics.CGImageGetWidth
+import platform.Foundation.CFBridgingRelease
+import platform.Foundation.CFBridgingRetain
+import platform.Foundation.NSData
+import platform.Foundation.NSNumber
+import platform.Foundation.create
+import platform.ImageIO.CGImageSourceCreateThumbnailAtIndex
+import platform.ImageIO.CGImageSourceCreateWithData
+import platform.ImageIO.CGImageSourceRef
+import platform.ImageIO.kCGImageSourceCreateThumbnailFromImageAlways
+import platform.ImageIO.kCGImageSourceCreateThumbnailWithTransform
+import platform.ImageIO.kCGImageSourceShouldCacheImmediately
+import platform.ImageIO.kCGImageSourceThumbnailMaxPixelSize
+import platform.UIKit.UIImage
+import platform.UIKit.UIImageJPEGRepresentation
+import platform.posix.memcpy
+
+actual class ImagePreprocessor actual constructor(private val config: ImagePreprocessConfig) {
+
+    actual suspend fun preprocess(bytes: ByteArray): ByteArray = preprocess(bytes.toNSData()).toByteArray()
+
+    /** Same as [preprocess] for Swift callers, without copying through a Kotlin array. */
+    suspend fun preprocess(data: NSData): NSData = withContext(Dispatchers.Default) {
+        val cfData = CFBridgingRetain(data) as CFDataRef?
+        val source = try {
+            CGImageSourceCreateWithData(cfData, null)   // retains the data itself
+        } finally {
+            CFBridgingRelease(cfData)
+        } ?: throw IllegalArgumentException("Not a decodable image")
+        try {
+            encode(source)
+        } finally {
+            CFRelease(source)
+        }
+    }
+
+    // ImageIO's thumbnail path decodes subsampled straight to the target size and,
+    // with the transform flag, bakes the EXIF orientation into the pixels.
+    private fun encode(source: CGImageSourceRef): NSData {
+        val options = CFDictionaryCreateMutable(null, 4, kCFTypeDictionaryKeyCallBacks.ptr, kCFTypeDictionaryValueCallBacks.ptr)
+        val maxEdge = CFBridgingRetain(NSNumber(int = config.maxEdgePx))
+        CFDictionarySetValue(options, kCGImageSourceCreateThumbnailFromImageAlways, kCFBooleanTrue)
+        CFDictionarySetValue(options, kCGImageSourceCreateThumbnailWithTransform, kCFBooleanTrue)
+        CFDictionarySetValue(options, kCGImageSourceShouldCacheImmediately, kCFBooleanTrue)
+        CFDictionarySetValue(options, kCGImageSourceThumbnailMaxPixelSize, maxEdge)
+        val image = try {
+            CGImageSourceCreateThumbnailAtIndex(source, 0u, options)
+        } finally {
+            CFBridgingRelease(maxEdge)
+            CFRelease(options)
+        } ?: throw IllegalArgumentException("Not a decodable image")
+
+        try {
+            if (CGImageGetWidth(image) == 0uL || CGImageGetHeight(image) == 0uL) {
+                throw IllegalArgumentException("Not a decodable image")
+            }
+            // a UIImage built from bare pixels carries no metadata, so EXIF/GPS are dropped
+            val upright = UIImage.imageWithCGImage(image)
+            return ImageSizing.encodeWithinBudget(
+                config,
+                encode = { quality ->
+                    UIImageJPEGRepresentation(upright, quality / 100.0)
+                        ?: throw IllegalStateException("JPEG encoding failed")
+                },
+                sizeOf = { it.length.toInt() }
+            )
+        } finally {
+            CFRelease(image)
+        }
+    }
+}
+
+internal fun ByteArray.toNSData(): NSData =
+    if (isEmpty()) NSData() else usePinned { NSData.create(bytes = it.addressOf(0), length = size.toULong()) }
+
+internal fun NSData.toByteArray(): ByteArray =
+    ByteArray(length.toInt()).also { out ->
+        if (out.isNotEmpty()) out.usePinned { memcpy(it.addressOf(0), bytes, length) }
+    }
@@ -0,0 +1,16 @@
+package org.example.project.image
+
+import org.example.project.Closeable
+import platform.Foundation.NSData
+
+/** Swift entry point to the upload queue; install [CloudinaryTransport.bridge] first. */
+object ImageUploads {
+    val uploader: ImageUploader by lazy { QueuedImageUploader(CloudinaryTransport()) }
+
+    /** Uploads [data]; callbacks run on the main thread and [Closeable.close] cancels. */
+    fun start(
+        data: NSData,
+        onProgress: (UploadProgress) -> Unit,
+        onError: (Throwable) -> Unit
+    ): Closeable = uploader.start(data.toByteArray(), onProgress, onError)
+}
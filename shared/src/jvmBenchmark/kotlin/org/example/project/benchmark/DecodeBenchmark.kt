@@ -0,0 +1,41 @@
+package org.example.project.benchmark
+
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.BenchmarkMode
+import kotlinx.benchmark.BenchmarkTimeUnit
+import kotlinx.benchmark.Blackhole
+import kotlinx.benchmark.Mode
+import kotlinx.benchmark.OutputTimeUnit
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import org.example.project.data.firebase.ReportDocumentDecoder
+
+/** Firestore document decoding over a mix of clean and legacy documents, as the repository reads them. */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(BenchmarkTimeUnit.MILLISECONDS)
+class DecodeBenchmark {
+    @Param("1000", "10000", "100000", "1000000")
+    var size = 0
+
+    private lateinit var documents: List<Pair<String, Map<String, Any?>>>
+
+    @Setup
+    fun setUp() {
+        documents = SyntheticReports.documents(SyntheticReports.generate(size))
+    }
+
+    @Benchmark
+    fun decode(blackhole: Blackhole) {
+        for ((id, fields) in documents) blackhole.consume(ReportDocumentDecoder.decode(id, fields))
+    }
+
+    // What getAllReports does with a snapshot
+    @Benchmark
+    fun decodeAndSort() = documents
+        .map { (id, fields) -> ReportDocumentDecoder.decode(id, fields) }
+        .filterNot { it.deleted }
+        .sortedByDescending { it.createdAt }
+}
@@ -0,0 +1,81 @@
+package org.example.project.benchmark
+
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.BenchmarkMode
+import kotlinx.benchmark.BenchmarkTimeUnit
+import kotlinx.benchmark.Mode
+import kotlinx.benchmark.OutputTimeUnit
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import org.example.project.data.report.ReportModel
+import org.example.project.data.report.toGeoPoints
+import org.example.project.geo.DistanceKernel
+import org.example.project.geo.GeoPoints
+import org.example.project.geo.haversineMeters
+
+/**
+ * The columnar distance kernel against the per-object loop it replaces: every
+ * distance from one point, and a radius filter, over reports held in memory.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(BenchmarkTimeUnit.MICROSECONDS)
+class DistanceKernelBenchmark {
+    @Param("10000", "100000", "1000000")
+    var size = 0
+
+    private lateinit var reports: List<ReportModel>
+    private lateinit var points: GeoPoints
+    private lateinit var out: DoubleArray
+    private lateinit var indices: IntArray
+
+    @Setup
+    fun setUp() {
+        reports = SyntheticReports.generate(size)
+        points = reports.toGeoPoints()
+        out = DoubleArray(size)
+        indices = IntArray(size)
+    }
+
+    @Benchmark
+    fun distancesPerObject(): DoubleArray {
+        for (i in reports.indices) {
+            val r = reports[i]
+            out[i] = haversineMeters(LAT, LNG, r.lat, r.lng)
+        }
+        return out
+    }
+
+    @Benchmark
+    fun distancesKernel(): DoubleArray {
+        DistanceKernel.haversine(points, LAT, LNG, out)
+        return out
+    }
+
+    @Benchmark
+    fun chordSqKernel(): DoubleArray {
+        DistanceKernel.chordSq(points, LAT, LNG, out)
+        return out
+    }
+
+    @Benchmark
+    fun equirectangularKernel(): DoubleArray {
+        DistanceKernel.equirectangular(points, LAT, LNG, out)
+        return out
+    }
+
+    @Benchmark
+    fun radiusPerObject() = reports.filter { haversineMeters(LAT, LNG, it.lat, it.lng) <= RADIUS_M }
+
+    @Benchmark
+    fun radiusKernel() = DistanceKernel.withinRadius(points, LAT, LNG, RADIUS_M, indices, out)
+
+    private companion object {
+        // central Tel Aviv
+        const val LAT = 32.08
+        const val LNG = 34.78
+        const val RADIUS_M = 10_000.0
+    }
+}
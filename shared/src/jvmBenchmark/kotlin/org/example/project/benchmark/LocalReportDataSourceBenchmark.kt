@@ -0,0 +1,57 @@
+package org.example.project.benchmark
+
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.BenchmarkMode
+import kotlinx.benchmark.BenchmarkTimeUnit
+import kotlinx.benchmark.Mode
+import kotlinx.benchmark.OutputTimeUnit
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import org.example.project.data.report.ReportModel
+
+/**
+ * The SQLite layer at production sizes: bulk upserts (every row already present,
+ * as on a resync), a user's full replace, and the two list reads.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(BenchmarkTimeUnit.MILLISECONDS)
+class LocalReportDataSourceBenchmark {
+    @Param("1000", "10000", "100000", "1000000")
+    var size = 0
+
+    private lateinit var reports: List<ReportModel>
+    private lateinit var userReports: List<ReportModel>
+    private lateinit var database: ReportDatabase
+
+    @Setup
+    fun setUp() {
+        reports = SyntheticReports.generate(size)
+        userReports = reports.filter { it.userId == USER }
+        database = ReportDatabase(reports)
+    }
+
+    @TearDown
+    fun tearDown() = database.close()
+
+    @Benchmark
+    fun upsertAll() = database.db.transaction {
+        reports.forEach(database.local::upsert)
+    }
+
+    @Benchmark
+    fun replaceAllForUser() = database.local.replaceAllForUser(USER, userReports)
+
+    @Benchmark
+    fun selectAll() = database.local.getAll()
+
+    @Benchmark
+    fun selectByUser() = database.local.getByUser(USER)
+
+    private companion object {
+        const val USER = "u0"
+    }
+}
@@ -0,0 +1,72 @@
+package org.example.project.benchmark
+
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.BenchmarkMode
+import kotlinx.benchmark.BenchmarkTimeUnit
+import kotlinx.benchmark.Mode
+import kotlinx.benchmark.OutputTimeUnit
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import org.example.project.data.report.ReportModel
+import org.example.project.data.report.reportClusterIndex
+import org.example.project.geo.GeoBounds
+import org.example.project.geo.MarkerClusterIndex
+
+/**
+ * The map and search paths against their baselines: the R*Tree box lookup vs a
+ * plain range scan, full rows vs columnar pins, FTS5 vs LIKE, and building vs
+ * querying the cluster index.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(BenchmarkTimeUnit.MICROSECONDS)
+class MapQueryBenchmark {
+    @Param("1000", "10000", "100000", "1000000")
+    var size = 0
+
+    private lateinit var reports: List<ReportModel>
+    private lateinit var database: ReportDatabase
+    private lateinit var clusters: MarkerClusterIndex<ReportModel>
+
+    @Setup
+    fun setUp() {
+        reports = SyntheticReports.generate(size)
+        database = ReportDatabase(reports)
+        clusters = reportClusterIndex(reports)
+    }
+
+    @TearDown
+    fun tearDown() = database.close()
+
+    @Benchmark
+    fun boxRtree() = database.local.getInBounds(CITY_VIEWPORT)
+
+    @Benchmark
+    fun boxScan() = with(CITY_VIEWPORT) {
+        database.db.reportQueries.selectInBoundingBox(south, north, west, east).executeAsList()
+    }
+
+    @Benchmark
+    fun boxPins() = database.local.getPinsInBounds(CITY_VIEWPORT)
+
+    @Benchmark
+    fun searchFts() = database.local.search(QUERY, limit = 50)
+
+    @Benchmark
+    fun searchLike() = database.db.reportQueries.searchLike(QUERY, 50).executeAsList()
+
+    @Benchmark
+    fun clusterBuild() = reportClusterIndex(reports)
+
+    @Benchmark
+    fun clusterQuery() = clusters.getClusters(CITY_VIEWPORT.expandedBy(0.5), 12.0)
+
+    private companion object {
+        // roughly Tel Aviv at zoom 12
+        val CITY_VIEWPORT = GeoBounds(south = 32.0, west = 34.7, north = 32.15, east = 34.9)
+        const val QUERY = "golden"
+    }
+}
@@ -0,0 +1,43 @@
+package org.example.project.benchmark
+
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.BenchmarkMode
+import kotlinx.benchmark.BenchmarkTimeUnit
+import kotlinx.benchmark.Mode
+import kotlinx.benchmark.OutputTimeUnit
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.serialization.json.Json
+import org.example.project.data.report.ReportModel
+import org.example.project.data.report.ReportStore
+import java.net.URLDecoder
+import java.net.URLEncoder
+
+/**
+ * Opening a report screen: the JSON round trip navigation used to do through the
+ * route (encode, URL-encode, decode), against the id lookup in [ReportStore].
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(BenchmarkTimeUnit.NANOSECONDS)
+class NavigationBenchmark {
+    private lateinit var report: ReportModel
+    private val store = ReportStore { error("not used by get") }
+
+    @Setup
+    fun setUp() {
+        val reports = SyntheticReports.generate(10_000)
+        report = reports[reports.size / 2]
+        store.putAll(reports)
+    }
+
+    @Benchmark
+    fun jsonRoundTrip(): ReportModel {
+        val route = URLEncoder.encode(Json.encodeToString(ReportModel.serializer(), report), "UTF-8")
+        return Json.decodeFromString(ReportModel.serializer(), URLDecoder.decode(route, "UTF-8"))
+    }
+
+    @Benchmark
+    fun storeLookup() = store.get(report.id)
+}
@@ -0,0 +1,62 @@
+package org.example.project.benchmark
+
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.BenchmarkMode
+import kotlinx.benchmark.BenchmarkTimeUnit
+import kotlinx.benchmark.Mode
+import kotlinx.benchmark.OutputTimeUnit
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import org.example.project.geo.haversineMeters
+
+/**
+ * "Reports near me": the expanding R*Tree search against a full scan that ranks
+ * every row by haversine. Queried from a dense spot (central Tel Aviv), a sparse
+ * one (the Negev) and one outside the data (the sea), where the search keeps
+ * growing to its radius limit.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(BenchmarkTimeUnit.MICROSECONDS)
+class NearestBenchmark {
+    @Param("100000", "1000000")
+    var size = 0
+
+    @Param("dense", "sparse", "empty")
+    var spot = ""
+
+    private lateinit var database: ReportDatabase
+    private var lat = 0.0
+    private var lng = 0.0
+
+    @Setup
+    fun setUp() {
+        database = ReportDatabase(SyntheticReports.generate(size))
+        when (spot) {
+            "dense" -> { lat = 32.08; lng = 34.78 }
+            "sparse" -> { lat = 30.6; lng = 34.8 }
+            else -> { lat = 33.0; lng = 33.0 }
+        }
+    }
+
+    @TearDown
+    fun tearDown() = database.close()
+
+    @Benchmark
+    fun nearestRtree() = database.local.getNearest(lat, lng, K, RADIUS_M)
+
+    @Benchmark
+    fun nearestScan() = database.db.reportQueries.selectAll().executeAsList()
+        .map { it to haversineMeters(lat, lng, it.lat ?: Double.NaN, it.lng ?: Double.NaN) }
+        .filter { it.second <= RADIUS_M }
+        .sortedBy { it.second }
+        .take(K)
+
+    private companion object {
+        const val K = 20
+        const val RADIUS_M = 50_000.0
+    }
+}
@@ -0,0 +1,48 @@
+package org.example.project.benchmark
+
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.BenchmarkMode
+import kotlinx.benchmark.BenchmarkTimeUnit
+import kotlinx.benchmark.Mode
+import kotlinx.benchmark.OutputTimeUnit
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.State
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.cancelAndJoin
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.runBlocking
+import org.example.project.data.firebase.FakeFirebaseRepository
+import org.example.project.data.report.ReportSyncEngine
+
+/**
+ * Snapshot-listener load: [size] generated inserts, edits and deletes pushed
+ * through [ReportSyncEngine.streamChanges] into an empty SQLite, timed until the
+ * last one is applied. Events per second is `size / time`. Each invocation
+ * opens its own database, which is small next to the load itself.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(BenchmarkTimeUnit.MILLISECONDS)
+class StreamChangesBenchmark {
+    @Param("10000", "100000")
+    var size = 0
+
+    @Param("1", "200")
+    var batchSize = 0
+
+    @Benchmark
+    fun streamChanges() = runBlocking {
+        ReportDatabase(emptyList()).use { database ->
+            val firebase = FakeFirebaseRepository()
+            val engine = ReportSyncEngine(firebase, database.local, Dispatchers.Default)
+            val stream = launch(Dispatchers.Default) { engine.streamChanges() }
+
+            firebase.generateLoad(total = size, batchSize = batchSize)
+            val last = firebase.getReportChangesSince(0).maxOf { it.updatedAt }
+            while ((database.local.highWaterMark(ReportSyncEngine.COLLECTION) ?: 0L) < last) delay(1)
+            stream.cancelAndJoin()
+        }
+    }
+}
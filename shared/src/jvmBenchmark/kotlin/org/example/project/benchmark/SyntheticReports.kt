@@ -0,0 +1,83 @@
+package org.example.project.benchmark
+
+import org.example.project.data.report.AppDatabase
+import org.example.project.data.report.DatabaseDriverFactory
+import org.example.project.data.report.LocalReportDataSource
+import org.example.project.data.report.ReportModel
+import kotlin.random.Random
+
+/**
+ * Deterministic report datasets for the benchmarks: the same seed always gives
+ * the same reports, so runs on different machines and releases are comparable.
+ */
+object SyntheticReports {
+    const val USERS = 100
+
+    private val words = listOf(
+        "brown", "black", "white", "small", "large", "labrador", "terrier", "collar",
+        "friendly", "shy", "puppy", "old", "park", "beach", "street", "near", "school",
+        "limping", "chip", "spotted", "golden", "husky", "poodle", "mixed", "tail"
+    )
+    private val cities = listOf("Tel Aviv", "Haifa", "Jerusalem", "Beersheba", "Eilat", "Netanya", "Ashdod")
+
+    fun generate(size: Int, seed: Int = 42): List<ReportModel> {
+        val random = Random(seed)
+        return List(size) { i ->
+            ReportModel(
+                id = "r%08d".format(i),
+                userId = "u${random.nextInt(USERS)}",
+                description = List(6 + random.nextInt(10)) { words[random.nextInt(words.size)] }.joinToString(" "),
+                name = "Reporter $i",
+                phone = "+9725${random.nextInt(10_000_000, 99_999_999)}",
+                imageUrl = "https://res.cloudinary.com/demo/image/upload/v1/reports/$i.jpg",
+                isLost = random.nextBoolean(),
+                location = cities[random.nextInt(cities.size)],
+                // Israel's bounding box, where the app's reports cluster
+                lat = 29.5 + random.nextDouble() * 3.8,
+                lng = 34.2 + random.nextDouble() * 1.7,
+                createdAt = 1_600_000_000_000L + random.nextLong(150_000_000_000L),
+                updatedAt = 1_700_000_000_000L + i
+            )
+        }
+    }
+
+    /**
+     * Raw Firestore fields for [reports], with [legacyShare] of them written the
+     * way older app versions did: coordinates and timestamps as strings, numeric
+     * flags, and fields added later missing altogether.
+     */
+    fun documents(reports: List<ReportModel>, legacyShare: Double = 0.3, seed: Int = 7): List<Pair<String, Map<String, Any?>>> {
+        val random = Random(seed)
+        return reports.map { r ->
+            val fields: Map<String, Any?> = if (random.nextDouble() < legacyShare) {
+                mapOf(
+                    "userId" to r.userId, "description" to r.description, "name" to r.name,
+                    "phone" to r.phone, "imageUrl" to r.imageUrl, "isLost" to if (r.isLost) 1L else 0L,
+                    "location" to r.location, "lat" to r.lat.toString(), "lng" to r.lng.toString(),
+                    "createdAt" to r.createdAt.toString()
+                )
+            } else {
+                mapOf(
+                    "userId" to r.userId, "description" to r.description, "name" to r.name,
+                    "phone" to r.phone, "imageUrl" to r.imageUrl, "isLost" to r.isLost,
+                    "location" to r.location, "lat" to r.lat, "lng" to r.lng,
+                    "createdAt" to r.createdAt, "updatedAt" to r.updatedAt, "deleted" to false
+                )
+            }
+            r.id to fields
+        }
+    }
+}
+
+/** A fresh in-memory database holding [reports]. */
+class ReportDatabase(reports: List<ReportModel>) : AutoCloseable {
+    private val driver = DatabaseDriverFactory().createDriver()
+    val db = AppDatabase(driver)
+    val local = LocalReportDataSource(db)
+
+    init {
+        db.transaction { reports.forEach(local::upsert) }
+    }
+
+    override fun close() = driver.close()
+}
@@ -0,0 +1,32 @@
+package org.example.project.data.report
+
+import app.cash.sqldelight.db.SqlDriver
+import app.cash.sqldelight.driver.jdbc.sqlite.JdbcSqliteDriver
+import java.util.Properties
+
+/**
+ * SQLite through sqlite-jdbc, which bundles the R*Tree and FTS5 modules the
+ * schema needs. With a [path] the database lives in that file and is created or
+ * migrated like the app's on open; without one it is in memory and gone when
+ * the driver closes.
+ */
+actual class DatabaseDriverFactory(private val path: String? = null) {
+    actual fun createDriver(): SqlDriver =
+        JdbcSqliteDriver(
+            url = if (path == null) JdbcSqliteDriver.IN_MEMORY else "jdbc:sqlite:$path",
+            properties = if (path == null) Properties() else fileProperties(),
+            schema = AppDatabase.Schema,
+            callbacks = *ReportMigrations.callbacks
+        )
+
+    // The journal mode and sync level Android and iOS open app.db with
+    private fun fileProperties() = Properties().apply {
+        setProperty("journal_mode", "WAL")
+        setProperty("synchronous", "NORMAL")
+    }
+
+    companion object {
+        fun inMemory() = DatabaseDriverFactory()
+        fun file(path: String) = DatabaseDriverFactory(path)
+    }
+}
@@ -0,0 +1,9 @@
+package org.example.project.image
+
+// Cloudinary ships no JVM SDK the app can share; jvm tests upload to a local HTTP host instead.
+actual class CloudinaryTransport actual constructor() : UploadTransport {
+    actual override suspend fun send(
+        bytes: ByteArray,
+        onProgress: (sentBytes: Long, totalBytes: Long) -> Unit
+    ): String = throw UnsupportedOperationException("No Cloudinary transport on the JVM")
+}
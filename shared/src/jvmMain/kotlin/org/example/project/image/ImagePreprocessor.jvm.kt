@@ -0,0 +1,45 @@
+package org.example.project.image
+
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.withContext
+import java.awt.RenderingHints
+import java.awt.image.BufferedImage
+import java.io.ByteArrayOutputStream
+import java.io.IOException
+import javax.imageio.IIOImage
+import javax.imageio.ImageIO
+import javax.imageio.ImageWriteParam
+
+// javax.imageio reads no EXIF, so unlike the phone builds orientation is left as stored.
+actual class ImagePreprocessor actual constructor(private val config: ImagePreprocessConfig) {
+
+    actual suspend fun preprocess(bytes: ByteArray): ByteArray = withContext(Dispatchers.Default) {
+        val source = ImageIO.read(bytes.inputStream()) ?: throw IOException("Not a decodable image")
+        val (width, height) = ImageSizing.fit(source.width, source.height, config.maxEdgePx)
+        val scaled = BufferedImage(width, height, BufferedImage.TYPE_INT_RGB)
+        scaled.createGraphics().apply {
+            setRenderingHint(RenderingHints.KEY_INTERPOLATION, RenderingHints.VALUE_INTERPOLATION_BILINEAR)
+            drawImage(source, 0, 0, width, height, null)
+            dispose()
+        }
+        ImageSizing.encodeWithinBudget(config, encode = { quality -> scaled.toJpeg(quality) }, sizeOf = { it.size })
+    }
+
+    private fun BufferedImage.toJpeg(quality: Int): ByteArray {
+        val writer = ImageIO.getImageWritersByFormatName("jpeg").next()
+        val out = ByteArrayOutputStream()
+        try {
+            ImageIO.createImageOutputStream(out).use { stream ->
+                writer.output = stream
+                val params = writer.defaultWriteParam.apply {
+                    compressionMode = ImageWriteParam.MODE_EXPLICIT
+                    compressionQuality = quality / 100f
+                }
+                writer.write(null, IIOImage(this, null, null), params)
+            }
+        } finally {
+            writer.dispose()
+        }
+        return out.toByteArray()
+    }
+}
@@ -0,0 +1,5 @@
+package org.example.project.location
+
+// The JVM target runs benchmarks and tests on build hosts, which have no location source.
+actual suspend fun getLocation(): Location =
+    throw IllegalStateException("Location unavailable on the JVM")
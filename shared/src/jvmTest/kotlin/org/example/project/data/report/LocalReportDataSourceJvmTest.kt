@@ -0,0 +1,164 @@
+package org.example.project.data.report
+
+import app.cash.sqldelight.db.SqlDriver
+import org.example.project.geo.GeoBounds
+import org.example.project.geo.haversineMeters
+import java.io.File
+import kotlin.io.path.createTempDirectory
+import kotlin.random.Random
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertNull
+import kotlin.test.assertTrue
+
+class LocalReportDataSourceJvmTest {
+    private val drivers = mutableListOf<SqlDriver>()
+
+    private fun open(factory: DatabaseDriverFactory = DatabaseDriverFactory.inMemory()): LocalReportDataSource {
+        val driver = factory.createDriver().also { drivers += it }
+        return LocalReportDataSource(AppDatabase(driver))
+    }
+
+    @AfterTest
+    fun closeDrivers() = drivers.forEach { it.close() }
+
+    private fun report(id: String, userId: String = "u1", createdAt: Long = 0, lat: Double = 32.08, lng: Double = 34.78) =
+        ReportModel(id = id, userId = userId, description = "brown labrador $id", createdAt = createdAt, lat = lat, lng = lng)
+
+    @Test
+    fun listsNewestFirstAndByUser() {
+        val local = open()
+        local.upsert(report("a", createdAt = 1))
+        local.upsert(report("b", userId = "u2", createdAt = 3))
+        local.upsert(report("c", createdAt = 2))
+
+        assertEquals(listOf("b", "c", "a"), local.getAll().map { it.id })
+        assertEquals(listOf("c", "a"), local.getByUser("u1").map { it.id })
+    }
+
+    @Test
+    fun replaceAllForUserLeavesOtherUsersAlone() {
+        val local = open()
+        local.upsert(report("a"))
+        local.upsert(report("b", userId = "u2"))
+
+        local.replaceAllForUser("u1", listOf(report("c")))
+
+        assertEquals(setOf("b", "c"), local.getAll().map { it.id }.toSet())
+    }
+
+    @Test
+    fun rtreeAndFullTextIndexesFollowUpserts() {
+        val local = open()
+        local.upsert(report("telaviv"))
+        local.upsert(report("haifa", lat = 32.8, lng = 34.99))
+
+        val telAviv = GeoBounds(south = 32.0, west = 34.7, north = 32.15, east = 34.9)
+        assertEquals(listOf("telaviv"), local.getInBounds(telAviv).map { it.id })
+
+        local.upsert(report("telaviv").copy(lat = 29.55, lng = 34.95))   // moved to Eilat
+        assertTrue(local.getInBounds(telAviv).isEmpty())
+
+        assertEquals(setOf("telaviv", "haifa"), local.search("labra").map { it.id }.toSet())
+    }
+
+    @Test
+    fun pinsInBoundsMatchTheReportsInBounds() {
+        val local = open()
+        local.upsert(report("old", createdAt = 1).copy(name = "Rex", imageUrl = "https://img/rex.jpg"))
+        local.upsert(report("new", createdAt = 2))
+        local.upsert(report("haifa", lat = 32.8, lng = 34.99))
+
+        val telAviv = GeoBounds(south = 32.0, west = 34.7, north = 32.15, east = 34.9)
+        val pins = local.getPinsInBounds(telAviv)
+
+        assertEquals(local.getInBounds(telAviv).map { it.id }, List(pins.size) { pins.id(it) })
+        assertEquals(listOf("", "Rex"), List(pins.size) { pins.label(it) })
+        assertEquals(listOf(false, true), List(pins.size) { pins.hasImage(it) })
+        assertEquals(listOf("", "https://img/rex.jpg"), List(pins.size) { pins.imageUrl(it) })
+        assertEquals(1, local.getPinsInBounds(telAviv, limit = 1).size)
+    }
+
+    @Test
+    fun nearestMatchesABruteForceHaversineRanking() {
+        val local = open()
+        val random = Random(3)
+        val reports = List(2_000) { i ->
+            // dense in Tel Aviv, sparse across the rest of the country
+            if (i % 4 == 0) report("r$i", lat = 32.05 + random.nextDouble() * 0.1, lng = 34.75 + random.nextDouble() * 0.1)
+            else report("r$i", lat = 29.5 + random.nextDouble() * 3.8, lng = 34.2 + random.nextDouble() * 1.7)
+        }
+        reports.forEach { local.upsert(it) }
+
+        for ((lat, lng) in listOf(32.08 to 34.78, 30.6 to 34.8, 33.2 to 35.5)) {
+            val expected = reports
+                .map { it.id to haversineMeters(lat, lng, it.lat, it.lng) }
+                .filter { it.second <= 20_000.0 }
+                .sortedBy { it.second }
+                .take(15)
+            val nearest = local.getNearest(lat, lng, k = 15, maxRadiusMeters = 20_000.0)
+            assertEquals(expected.map { it.first }, nearest.map { it.report.id })
+            assertEquals(expected.map { it.second }, nearest.map { it.distanceMeters })
+        }
+    }
+
+    @Test
+    fun nearestStopsAtTheRadius() {
+        val local = open()
+        local.upsert(report("near", lat = 32.08, lng = 34.78))
+        local.upsert(report("far", lat = 31.77, lng = 35.21))   // Jerusalem, ~54 km
+
+        assertEquals(listOf("near"), local.getNearest(32.08, 34.781, k = 5, maxRadiusMeters = 10_000.0).map { it.report.id })
+        assertEquals(listOf("near", "far"), local.getNearest(32.08, 34.781, k = 5, maxRadiusMeters = 100_000.0).map { it.report.id })
+        assertTrue(local.getNearest(32.08, 34.781, k = 0, maxRadiusMeters = 100_000.0).isEmpty())
+    }
+
+    @Test
+    fun outboxFoldsLocalWritesUntilAcknowledged() {
+        val local = open()
+        local.saveLocally(report("a"), now = 10)
+        local.updateLocally("a", ReportPatch(description = "found near the beach"), now = 11)
+
+        val claims = local.claimOutbox(now = 20, limit = 10)
+        assertEquals(1, claims.size)
+        val write = claims.single().write
+        assertTrue(write is ReportWrite.Create && write.report.description == "found near the beach")
+
+        local.acknowledgeOutbox(claims)
+        assertEquals(0, local.countPendingWrites())
+        assertNull(local.nextOutboxAttemptAt())
+    }
+
+    @Test
+    fun claimedOutboxEntriesAreLeasedToOneSender() {
+        val local = open()
+        local.saveLocally(report("a"), now = 10)
+
+        val claims = local.claimOutbox(now = 20, limit = 10)
+        assertEquals(1, claims.size)
+        assertTrue(local.claimOutbox(now = 21, limit = 10).isEmpty())
+        assertEquals(20 + LocalReportDataSource.OUTBOX_LEASE_MS, local.nextOutboxAttemptAt())
+
+        // a sender that never acked: the entry goes out again once the lease runs out
+        val retaken = local.claimOutbox(now = 20 + LocalReportDataSource.OUTBOX_LEASE_MS, limit = 10)
+        assertEquals(listOf(2L), retaken.map { it.attempts })
+    }
+
+    @Test
+    fun fileDatabaseSurvivesReopening() {
+        val dir = createTempDirectory("reports").toFile()
+        try {
+            val path = File(dir, "app.db").path
+            val first = DatabaseDriverFactory.file(path).createDriver()
+            LocalReportDataSource(AppDatabase(first)).upsert(report("kept"))
+            first.close()
+
+            val second = DatabaseDriverFactory.file(path).createDriver()
+            assertEquals(listOf("kept"), LocalReportDataSource(AppDatabase(second)).getAll().map { it.id })
+            second.close()
+        } finally {
+            dir.deleteRecursively()
+        }
+    }
+}
@@ -0,0 +1,82 @@
+package org.example.project.data.report
+
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.SupervisorJob
+import kotlinx.coroutines.cancel
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.flow.first
+import kotlinx.coroutines.runBlocking
+import kotlinx.coroutines.withTimeout
+import org.example.project.data.firebase.FakeFirebaseRepository
+import org.example.project.geo.GeoBounds
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFalse
+import kotlin.time.Duration
+
+// The repository, outbox and sync engine end to end, on a real SQLite and the in-memory Firestore.
+class ReportRepositoryJvmTest {
+    private val driver = DatabaseDriverFactory.inMemory().createDriver()
+    private val local = LocalReportDataSource(AppDatabase(driver))
+    private val firebase = FakeFirebaseRepository()
+    private val scope = CoroutineScope(SupervisorJob() + Dispatchers.Default)
+    private val outbox = ReportOutbox(firebase, local).also { it.start(scope) }
+    private val repository = ReportRepositoryImpl(firebase, local, scope, requests = ReportRequests(scope), outbox = outbox)
+
+    @AfterTest
+    fun tearDown() {
+        scope.cancel()
+        driver.close()
+    }
+
+    @Test
+    fun savedReportIsReadableAtOnceAndReachesFirestore() = runBlocking {
+        val saved = repository.saveReport("brown labrador", "Dana", "050", "", true, null, 32.08, 34.78)
+
+        assertEquals(saved.id, local.getById(saved.id)?.id)
+        withTimeout(5_000) {
+            while (local.countPendingWrites() > 0) delay(10)
+        }
+        assertEquals(listOf(saved.id), firebase.getAllReports().map { it.id })
+    }
+
+    @Test
+    fun refreshPullsRemoteReportsIntoSqlite() = runBlocking {
+        firebase.saveReport("found near the beach", "Noa", "052", "", false, null, 32.8, 34.99)
+
+        repository.refreshReports()
+
+        assertEquals(listOf("found near the beach"), local.getAll().map { it.description })
+    }
+
+    @Test
+    fun viewportClustersCountEveryPinInTheArea() = runBlocking {
+        repeat(3_000) { i ->
+            local.upsert(ReportModel(id = "r$i", description = "dog $i", lat = 32.05 + (i % 100) * 1e-4, lng = 34.78, createdAt = i.toLong()))
+        }
+        val loader = ViewportReportLoader(repository, debounce = Duration.ZERO)
+
+        loader.update(GeoBounds(south = 32.0, west = 34.7, north = 32.1, east = 34.9), zoom = 3.0)
+        val loaded = withTimeout(5_000) { loader.pins().first() }
+
+        assertFalse(loaded.truncated)
+        assertEquals(3_000, loaded.pins.size)
+        assertEquals(3_000, loaded.index.getClusters(GeoBounds(-90.0, -180.0, 90.0, 180.0), 3.0).sumOf { it.count })
+    }
+
+    @Test
+    fun recollectingThePinFlowLoadsTheViewportAgain() = runBlocking {
+        local.upsert(ReportModel(id = "a", description = "dog", lat = 32.05, lng = 34.78))
+        val loader = ViewportReportLoader(repository, debounce = Duration.ZERO)
+        loader.update(GeoBounds(south = 32.0, west = 34.7, north = 32.1, east = 34.9), zoom = 12.0)
+        val pins = loader.pins()
+
+        withTimeout(5_000) { pins.first() }
+        // the first collection covered this viewport; a new one must not inherit that
+        val again = withTimeout(5_000) { pins.first() }
+
+        assertEquals(1, again.pins.size)
+    }
+}
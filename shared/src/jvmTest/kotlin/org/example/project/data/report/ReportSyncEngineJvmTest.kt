@@ -0,0 +1,35 @@
+package org.example.project.data.report
+
+import kotlinx.coroutines.runBlocking
+import org.example.project.data.firebase.FakeFirebaseRepository
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+class ReportSyncEngineJvmTest {
+    private val driver = DatabaseDriverFactory.inMemory().createDriver()
+    private val local = LocalReportDataSource(AppDatabase(driver))
+    private val firebase = FakeFirebaseRepository()
+    private val now = 1_700_000_000_000L
+    private val engine = ReportSyncEngine(firebase, local, clock = { now })
+
+    @AfterTest
+    fun tearDown() {
+        driver.close()
+    }
+
+    private fun report(id: String, updatedAt: Long) =
+        ReportModel(id = id, description = id, lat = 32.08, lng = 34.78, createdAt = updatedAt, updatedAt = updatedAt)
+
+    @Test
+    fun futureDatedChangeDoesNotHideLaterChanges() = runBlocking {
+        firebase.putRemote(report("fast-clock", updatedAt = now + 60 * 60 * 1000L))   // a device an hour ahead
+        engine.sync()
+        assertEquals(now + ReportSyncEngine.CLOCK_SKEW_MS, local.highWaterMark(ReportSyncEngine.COLLECTION))
+
+        firebase.putRemote(report("honest", updatedAt = now + 1_000))
+        engine.sync()
+
+        assertEquals(setOf("fast-clock", "honest"), local.getAll().map { it.id }.toSet())
+    }
+}
@@ -0,0 +1,49 @@
+package org.example.project.data.report
+
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.cancelAndJoin
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.runBlocking
+import kotlinx.coroutines.withTimeout
+import org.example.project.data.firebase.FakeFirebaseRepository
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+// A burst of snapshot-listener events through ReportSyncEngine.streamChanges into a real SQLite.
+// Throughput is measured by StreamChangesBenchmark, not here.
+class ReportSyncLoadJvmTest {
+    private val driver = DatabaseDriverFactory.inMemory().createDriver()
+    private val local = LocalReportDataSource(AppDatabase(driver))
+    private val firebase = FakeFirebaseRepository()
+    private val engine = ReportSyncEngine(firebase, local, Dispatchers.Default)
+
+    @AfterTest
+    fun tearDown() {
+        driver.close()
+    }
+
+    @Test
+    fun streamedLoadEndsWithTheLastWritePerReport() = runBlocking {
+        val stream = launch(Dispatchers.Default) { engine.streamChanges() }
+
+        firebase.generateLoad(total = EVENTS, batchSize = 200)
+        // the last write per id: live reports with their final edit, deleted ones gone
+        val expected = firebase.getAllReports().associate { it.id to (it.description to it.updatedAt) }
+        withTimeout(30_000) {
+            while (local.getAll().associate { it.id to (it.description to it.updatedAt) } != expected) delay(20)
+        }
+        stream.cancelAndJoin()
+
+        assertEquals(expected.size.toLong(), local.countAll())
+        assertTrue(expected.isNotEmpty() && expected.size < EVENTS)   // the load edited and deleted as well
+        assertTrue(engine.streamedBatches in 1 until EVENTS)
+        assertTrue(engine.streamedBatches < engine.streamedChanges, "no burst was folded")
+    }
+
+    private companion object {
+        const val EVENTS = 20_000
+    }
+}
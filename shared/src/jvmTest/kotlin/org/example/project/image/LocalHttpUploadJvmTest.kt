@@ -0,0 +1,142 @@
+package org.example.project.image
+
+import com.sun.net.httpserver.HttpServer
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.flow.toList
+import kotlinx.coroutines.runBlocking
+import kotlinx.coroutines.runInterruptible
+import java.io.IOException
+import java.net.HttpURLConnection
+import java.net.InetSocketAddress
+import java.net.URL
+import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.Executors
+import java.util.concurrent.atomic.AtomicInteger
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertContentEquals
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertIs
+import kotlin.test.assertTrue
+
+// QueuedImageUploader against a real HTTP endpoint on localhost, standing in for the image host.
+class LocalHttpUploadJvmTest {
+    private val host = LocalImageHost(holdMs = 200)
+    private val photo = ByteArray(256 * 1024) { it.toByte() }
+
+    private fun uploader(maxParallel: Int = 2) =
+        QueuedImageUploader(HttpUploadTransport(host.uploadUrl), preprocessor = { null }, maxParallel = maxParallel)
+
+    @AfterTest
+    fun tearDown() = host.close()
+
+    @Test
+    fun uploadReachesTheHostAndEndsWithItsUrl() = runBlocking {
+        val events = uploader().upload(photo).toList()
+
+        val done = events.last()
+        assertIs<UploadProgress.Done>(done)
+        assertContentEquals(photo, host.stored(done.url))
+        val sent = events.filterIsInstance<UploadProgress.Sending>().map { it.sentBytes }
+        assertEquals(sent.sorted(), sent)
+        assertTrue(sent.all { it <= photo.size })
+    }
+
+    @Test
+    fun hostSeesAtMostMaxParallelUploads() = runBlocking {
+        val queue = uploader(maxParallel = 2)
+
+        val urls = List(6) { async { queue.awaitUrl(photo) } }.awaitAll()
+
+        assertEquals(6, urls.toSet().size)
+        assertEquals(2, host.peakParallel)
+    }
+
+    @Test
+    fun hostErrorFailsTheFlow() = runBlocking {
+        host.failing = true
+        assertFailsWith<IOException> { uploader().awaitUrl(photo) }
+    }
+}
+
+/** POSTs the bytes in chunks over HttpURLConnection; the body of the response is the URL. */
+private class HttpUploadTransport(private val endpoint: URL) : UploadTransport {
+    override suspend fun send(bytes: ByteArray, onProgress: (sentBytes: Long, totalBytes: Long) -> Unit): String =
+        runInterruptible(Dispatchers.IO) {
+            val connection = endpoint.openConnection() as HttpURLConnection
+            try {
+                connection.requestMethod = "POST"
+                connection.doOutput = true
+                connection.setFixedLengthStreamingMode(bytes.size)
+                connection.outputStream.use { out ->
+                    var sent = 0
+                    while (sent < bytes.size) {
+                        val chunk = minOf(CHUNK_BYTES, bytes.size - sent)
+                        out.write(bytes, sent, chunk)
+                        sent += chunk
+                        onProgress(sent.toLong(), bytes.size.toLong())
+                    }
+                }
+                if (connection.responseCode != HttpURLConnection.HTTP_OK) {
+                    throw IOException("Upload failed: HTTP ${connection.responseCode}")
+                }
+                connection.inputStream.use { it.readBytes().decodeToString() }
+            } finally {
+                connection.disconnect()
+            }
+        }
+
+    private companion object {
+        const val CHUNK_BYTES = 16 * 1024
+    }
+}
+
+/** Image host on an ephemeral localhost port; holds each upload [holdMs] so overlaps are visible. */
+private class LocalImageHost(private val holdMs: Long) : AutoCloseable {
+    private val images = ConcurrentHashMap<String, ByteArray>()
+    private val active = AtomicInteger()
+    private val peak = AtomicInteger()
+    private val nextId = AtomicInteger()
+    private val executor = Executors.newCachedThreadPool()
+    private val server = HttpServer.create(InetSocketAddress("127.0.0.1", 0), 0)
+
+    @Volatile
+    var failing = false
+
+    val peakParallel: Int get() = peak.get()
+    val uploadUrl: URL get() = URL("http://127.0.0.1:${server.address.port}/upload")
+
+    init {
+        server.executor = executor
+        server.createContext("/upload") { exchange ->
+            peak.accumulateAndGet(active.incrementAndGet()) { a, b -> maxOf(a, b) }
+            try {
+                val body = exchange.requestBody.readBytes()
+                Thread.sleep(holdMs)
+                if (failing) {
+                    exchange.sendResponseHeaders(500, -1)
+                } else {
+                    val url = "http://127.0.0.1:${server.address.port}/image/upload-${nextId.incrementAndGet()}.jpg"
+                    images[url] = body
+                    val reply = url.encodeToByteArray()
+                    exchange.sendResponseHeaders(200, reply.size.toLong())
+                    exchange.responseBody.write(reply)
+                }
+            } finally {
+                active.decrementAndGet()
+                exchange.close()
+            }
+        }
+        server.start()
+    }
+
+    fun stored(url: String): ByteArray? = images[url]
+
+    override fun close() {
+        server.stop(0)
+        executor.shutdownNow()
+    }
+}